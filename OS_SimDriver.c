@@ -39,6 +39,18 @@ int main( int argc, char **argv )
                 displayConfigData( configDataPtr );
             }
 
+            // check virtual timer flag, overrides config setting
+            if( cmdLineData.virtualTimerFlag )
+            {
+                configDataPtr->virtualTimer = true;
+            }
+
+            // check diagnostic stats flag
+            if( cmdLineData.diagnosticStatsFlag )
+            {
+                configDataPtr->diagnosticStats = true;
+            }
+
             // set config upload success flag
             configUploadSuccess = true;
         }
@@ -136,6 +148,8 @@ void clearCmdLineStruct( CmdLineData *clDataPtr )
     clDataPtr->configDisplayFlag = false;
     clDataPtr->mdDisplayFlag = false;
     clDataPtr->runSimFlag = false;
+    clDataPtr->virtualTimerFlag = false;
+    clDataPtr->diagnosticStatsFlag = false;
     clDataPtr->fileName[ 0 ] = NULL_CHAR;
 }
 
@@ -213,6 +227,22 @@ bool processCmdLine( int numArgs, char **strVector, CmdLineData *clDataPtr )
                 atLeastOneSwitchFlag = true;
             }
 
+            // check for -vt (virtual timer flag)
+            // does not count as a switch, a run option only
+            else if( compareString( strVector[ argIndex ], "-vt" ) == 0 )
+            {
+                // set virtual timer flag
+                clDataPtr->virtualTimerFlag = true;
+            }
+
+            // check for -ds (diagnostic stats flag)
+            // does not count as a switch, a run option only
+            else if( compareString( strVector[ argIndex ], "-ds" ) == 0 )
+            {
+                // set diagnostic stats flag
+                clDataPtr->diagnosticStatsFlag = true;
+            }
+
             // otherwise, check for file name, ending in .cfg
             // must be last four
             else
@@ -274,6 +304,8 @@ void showCommandLineFormat()
     printf( "     -dc [optional] displays configuration data\n" );
     printf( "     -dm [optional] displays meta data\n" );
     printf( "     -rs [optional] runs simulator\n" );
+    printf( "     -vt [optional] runs simulator on a simulated clock\n" );
+    printf( "     -ds [optional] displays simulator diagnostic stats\n" );
     printf( "     required config file name with .cnf extension\n" );
 }
 
@@ -18,6 +18,8 @@ typedef struct CmdLineDataStruct
     bool configDisplayFlag;
     bool mdDisplayFlag;
     bool runSimFlag;
+    bool virtualTimerFlag;
+    bool diagnosticStatsFlag;
 
     char fileName[ STD_STR_LEN ];
 } CmdLineData;
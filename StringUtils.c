@@ -83,7 +83,7 @@ void concatenateString( char *destStr, const char *sourceStr )
 
     // copy source string in case of aliasings
         // malloc, copyString
-    tempStr = (char *)malloc( sizeof( sourceStrLen + 1 ) );
+    tempStr = (char *)malloc( sizeof( char ) * ( sourceStrLen + 1 ) );
     copyString( tempStr, sourceStr );
 
     // loop to end of source string
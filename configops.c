@@ -47,9 +47,11 @@ Dependencies: copyString
 void configCodeToString( int code, char *outString )
 {
     // Define array with eight items, and short (10) lengths
-    char displayStrings[ 8 ][ 10 ] = { "SJF-N", "SRTF-P", "FCFS-P", 
-                                       "RR-P", "FCFS-N", "Monitor", 
-                                       "File", "Both" };
+    char displayStrings[ 17 ][ 10 ] = { "SJF-N", "SRTF-P", "FCFS-P", 
+                                        "RR-P", "FCFS-N", "Monitor", 
+                                        "File", "Both", "Non-P", "P", 
+                                        "FIFO", "SJF", "MLFQ-P", "CFS-P", 
+                                        "STRIDE-P", "LOTTERY-P", "EDF-P" };
 
     // copy string to return parameter
         // function: copyString
@@ -71,6 +73,7 @@ void displayConfigData( ConfigDataType *configData )
 {
     // initialize function/variables
     char displayString[ STD_STR_LEN ];
+    int index;
 
     // print lines of display for all member values
         // function: printf, codeToString (translates coded items)
@@ -96,7 +99,60 @@ void displayConfigData( ConfigDataType *configData )
     printf( "I/O cycle rate         : %d\n", configData->ioCycleRate );
     configCodeToString( configData->logToCode, displayString );
     printf( "Log to selection       : %s\n", displayString );
-    printf( "Log file name          : %s\n\n\n", configData->logToFileName );
+    printf( "Log file name          : %s\n", configData->logToFileName );
+    printf( "Timer spin slice       : %d\n", configData->spinSliceUSec );
+    printf( "Time dilation          : %4.3f\n", configData->timeDilation );
+    printf( "Device channels        : %d\n", configData->deviceChannels );
+    for( index = 0; index < configData->deviceConfigCount; index++ )
+    {
+        printf( "  %-21s: ", configData->deviceNames[ index ] );
+        if( configData->deviceChannelCounts[ index ] < 0 )
+        {
+            printf( "default channels" );
+        }
+        else
+        {
+            printf( "%d channels", configData->deviceChannelCounts[ index ] );
+        }
+        printf( ", priority %d\n", configData->devicePriorities[ index ] );
+    }
+    printf( "Max in-flight I/O      : %d\n", configData->maxInFlightIO );
+    printf( "Coalescing window (ms) : %d\n", configData->coalesceWindowMSec );
+    printf( "Coalescing count       : %d\n", configData->coalesceCount );
+    printf( "MLFQ levels            : %d\n", configData->mlfqLevels );
+    for( index = 0; index < configData->mlfqLevels; index++ )
+    {
+        printf( "  level %d quantum       : ", index );
+        if( configData->mlfqQuanta[ index ] == 0 )
+        {
+            printf( "default\n" );
+        }
+        else
+        {
+            printf( "%d\n", configData->mlfqQuanta[ index ] );
+        }
+    }
+    printf( "MLFQ boost interval    : %d\n", configData->mlfqBoostCycles );
+    printf( "CFS min granularity(ms): %d\n", configData->cfsGranularityMSec );
+    printf( "Lottery seed           : %d\n", configData->lotterySeed );
+    printf( "Device service order   : " );
+    if( configData->deviceServiceOrder == DEVICE_ORDER_SJF_CODE )
+    {
+        printf( "SJF\n" );
+    }
+    else
+    {
+        printf( "FIFO\n" );
+    }
+    printf( "Virtual timer          : " );
+    if( configData->virtualTimer )
+    {
+        printf( "On\n\n\n" );
+    }
+    else
+    {
+        printf( "Off\n\n\n" );
+    }
 }
 
 
@@ -120,7 +176,7 @@ bool getConfigData( const char *fileName,
 {
     // initialize function/variables
 
-        // set constant number of data lines
+        // set constant number of required data lines
         const int NUM_DATA_LINES = 10;
  
         // set read only constant
@@ -132,8 +188,9 @@ bool getConfigData( const char *fileName,
         // declare other variables
         FILE *fileAccessPtr;
         char dataBuffer[ MAX_STR_LEN ], lowerCaseDataBuffer[ MAX_STR_LEN ];
-        int intData, dataLineCode, lineCtr = 0;
+        int intData, dataLineCode, lineCtr = 0, index;
         double doubleData;
+        bool endLineFound = false;
 
     // set endStateMsg to success
         // function: copyStriing
@@ -181,8 +238,29 @@ bool getConfigData( const char *fileName,
         // function: malloc
     tempData = (ConfigDataType *) malloc( sizeof( ConfigDataType ) );
 
-    // loop to end of config data items
-    while( lineCtr < NUM_DATA_LINES )
+    // set defaults for optional config items
+    tempData->virtualTimer = false;
+    tempData->diagnosticStats = false;
+    tempData->spinSliceUSec = DEFAULT_SPIN_SLICE_USEC;
+    tempData->timeDilation = DEFAULT_TIME_DILATION;
+    tempData->deviceChannels = 0;
+    tempData->deviceServiceOrder = DEVICE_ORDER_FIFO_CODE;
+    tempData->deviceConfigCount = 0;
+    tempData->maxInFlightIO = 0;
+    tempData->coalesceWindowMSec = 0;
+    tempData->coalesceCount = 0;
+    tempData->mlfqLevels = DEFAULT_MLFQ_LEVELS;
+    tempData->mlfqBoostCycles = DEFAULT_MLFQ_BOOST_CYCLES;
+    tempData->cfsGranularityMSec = DEFAULT_CFS_GRANULARITY_MSEC;
+    tempData->lotterySeed = DEFAULT_LOTTERY_SEED;
+    for( index = 0; index < MAX_MLFQ_LEVELS; index++ )
+    {
+        tempData->mlfqQuanta[ index ] = 0;
+    }
+
+    // loop to end of config data items, 
+    //   optional items may follow the required items
+    while( !endLineFound )
     {
         // get line leade, check for failure
             // function: getStringToDelimiter
@@ -214,15 +292,23 @@ bool getConfigData( const char *fileName,
             // function: getDataLineCode
         dataLineCode = getDataLineCode( dataBuffer );
 
-        // check for data line found
-        if( dataLineCode != CFG_CORRUPT_PROMPT_ERR )
+        // check for end of config data items
+        if( dataLineCode == CFG_END_LINE_CODE )
+        {
+            // set end line found flag
+            endLineFound = true;
+        }
+
+        // otherwise, check for data line found
+        else if( dataLineCode != CFG_CORRUPT_PROMPT_ERR )
         {
             // get data value
 
-                // check for version number (double value)
-                if( dataLineCode == CFG_VERSION_CODE )
+                // check for version number or time dilation (double value)
+                if( dataLineCode == CFG_VERSION_CODE 
+                 || dataLineCode == CFG_TIME_DILATION_CODE )
                 {
-                    // get version number
+                    // get version number or time dilation
                         // function: fscanf
                     fscanf( fileAccessPtr, "%lf", &doubleData );
                 }
@@ -233,7 +319,9 @@ bool getConfigData( const char *fileName,
                       || dataLineCode == CFG_LOG_FILE_NAME_CODE 
                       || dataLineCode == CFG_CPU_SCHED_CODE 
                       || dataLineCode == CFG_LOG_TO_CODE 
-                      || dataLineCode == CFG_MEM_DISPLAY_CODE )
+                      || dataLineCode == CFG_MEM_DISPLAY_CODE 
+                      || dataLineCode == CFG_VIRTUAL_TIMER_CODE 
+                      || dataLineCode == CFG_DEVICE_ORDER_CODE )
                 {
                     // get string input
                         // function: fscanf
@@ -254,8 +342,15 @@ bool getConfigData( const char *fileName,
 
             // check for data value in range
                 // fucntion: valueInRange
+            // per device settings are limited to MAX_DEVICE_CONFIGS devices, 
+            //    mlfq quanta to levels below MAX_MLFQ_LEVELS
             if( valueInRange( dataLineCode, intData, 
-                                             doubleData, lowerCaseDataBuffer ) )
+                                             doubleData, lowerCaseDataBuffer ) 
+             && ( ( dataLineCode != CFG_DEVICE_CHANNEL_CODE 
+                    && dataLineCode != CFG_DEVICE_PRIORITY_CODE ) 
+                   || tempData->deviceConfigCount < MAX_DEVICE_CONFIGS ) 
+             && ( dataLineCode != CFG_MLFQ_QUANTUM_CODE 
+                   || getMLFQLevel( dataBuffer ) != NOT_IN_USE ) )
             {
                 // assign to data pointer depending on config item
                 // (all config line possibilities)
@@ -316,6 +411,97 @@ bool getConfigData( const char *fileName,
                        // memory was never allocated to tempData->logToFileName
                        copyString( tempData->logToFileName, dataBuffer );
                        break;
+
+                    case CFG_VIRTUAL_TIMER_CODE:
+
+                       tempData->virtualTimer
+                              = compareString( lowerCaseDataBuffer, "on" ) == 0;
+                       break;
+
+                    case CFG_SPIN_SLICE_CODE:
+
+                       tempData->spinSliceUSec = intData;
+                       break;
+
+                    case CFG_TIME_DILATION_CODE:
+
+                       tempData->timeDilation = doubleData;
+                       break;
+
+                    case CFG_DEVICE_CHANNELS_CODE:
+
+                       tempData->deviceChannels = intData;
+                       break;
+
+                    case CFG_DEVICE_CHANNEL_CODE:
+
+                       // device name is part of the leader line
+                       setDeviceChannels( tempData, dataBuffer, intData );
+                       break;
+
+                    case CFG_DEVICE_PRIORITY_CODE:
+
+                       // device name is part of the leader line
+                       setDevicePriority( tempData, dataBuffer, intData );
+                       break;
+
+                    case CFG_MAX_IN_FLIGHT_CODE:
+
+                       tempData->maxInFlightIO = intData;
+                       break;
+
+                    case CFG_COALESCE_WINDOW_CODE:
+
+                       tempData->coalesceWindowMSec = intData;
+                       break;
+
+                    case CFG_COALESCE_COUNT_CODE:
+
+                       tempData->coalesceCount = intData;
+                       break;
+
+                    case CFG_MLFQ_LEVELS_CODE:
+
+                       tempData->mlfqLevels = intData;
+                       break;
+
+                    case CFG_MLFQ_QUANTUM_CODE:
+
+                       // queue level is part of the leader line
+                       tempData->mlfqQuanta[ getMLFQLevel( dataBuffer ) ] 
+                                                                   = intData;
+                       break;
+
+                    case CFG_MLFQ_BOOST_CODE:
+
+                       tempData->mlfqBoostCycles = intData;
+                       break;
+
+                    case CFG_CFS_GRANULARITY_CODE:
+
+                       tempData->cfsGranularityMSec = intData;
+                       break;
+
+                    case CFG_LOTTERY_SEED_CODE:
+
+                       tempData->lotterySeed = intData;
+                       break;
+
+                    case CFG_DEVICE_ORDER_CODE:
+
+                       tempData->deviceServiceOrder = DEVICE_ORDER_FIFO_CODE;
+                       if( compareString( lowerCaseDataBuffer, "sjf" ) == 0 )
+                       {
+                           tempData->deviceServiceOrder 
+                                                     = DEVICE_ORDER_SJF_CODE;
+                       }
+                       break;
+                }
+
+                // count required config items found
+                if( dataLineCode <= CFG_LOG_FILE_NAME_CODE )
+                {
+                    lineCtr++;
                 }
             }
             // otherwise, assume data values not in range
@@ -355,15 +541,11 @@ bool getConfigData( const char *fileName,
             return false;
         }
 
-        // incrment line counter
-        lineCtr++;
     }
     // end master loop
 
-    // acquire end of sim config string
-        // function: getStringToDelimiter, compareString
-    if( !getStringToDelimiter( fileAccessPtr, PERIOD, dataBuffer )
-        || compareString( dataBuffer, "End Simulator Configuration File" ) != 0 )
+    // check for end of sim config string found before all required items
+    if( lineCtr < NUM_DATA_LINES )
     {
         // free temp struct memory
             // function: free
@@ -405,34 +587,24 @@ Function Output/Parameters: none
 Function Output/Returned: cpu schedule code (ConfigDataCodes)
 Device Input/Device: none
 Device Output/Device: none
-Dependencies: compareString
+Dependencies: findSchedulerByName
 */
 ConfigDataCodes getCpuSchedCode( const char *lowerCaseStr )
 {
     // initialize function/variables
 
-        // set default return to FCFS-N
-        ConfigDataCodes returnVal = CPU_SCHED_FCFS_N_CODE;
+        // find the scheduler with this name
+            // function: findSchedulerByName
+        const SchedulerOpsType *scheduler = findSchedulerByName( lowerCaseStr );
 
-    // check for each code, then set the corresponding code
-        // function: compareString
-    if( compareString( lowerCaseStr, "sjf-n" ) == 0 )
+    // default to FCFS-N if no scheduler has the name
+    if( scheduler == NULL )
     {
-        returnVal = CPU_SCHED_SJF_N_CODE;
-    }
-
-    else if( compareString( lowerCaseStr, "fcfs-p" ) == 0 )
-    {
-        returnVal = CPU_SCHED_FCFS_P_CODE;
-    }
-
-    else if( compareString( lowerCaseStr, "rr-p" ) == 0 )
-    {
-        returnVal = CPU_SCHED_RR_P_CODE;
+        return CPU_SCHED_FCFS_N_CODE;
     }
 
     // return the selected value
-    return returnVal;
+    return scheduler->schedCode;
 }
 
 
@@ -491,11 +663,134 @@ ConfigCodeMessages getDataLineCode( const char *dataBuffer )
     {
         return CFG_LOG_FILE_NAME_CODE;
     }
+    else if( compareString( dataBuffer, "Virtual Timer (On/Off)" ) == 0 )
+    {
+        return CFG_VIRTUAL_TIMER_CODE;
+    }
+    else if( compareString( dataBuffer, "Timer Spin Slice (usec)" ) == 0 )
+    {
+        return CFG_SPIN_SLICE_CODE;
+    }
+    else if( compareString( dataBuffer, "Time Dilation" ) == 0 )
+    {
+        return CFG_TIME_DILATION_CODE;
+    }
+    else if( compareString( dataBuffer, "Device Channels" ) == 0 )
+    {
+        return CFG_DEVICE_CHANNELS_CODE;
+    }
+    else if( findSubString( dataBuffer, "Device Channels (" ) == 0 
+          && dataBuffer[ getStringLength( dataBuffer ) - 1 ] == ')' )
+    {
+        return CFG_DEVICE_CHANNEL_CODE;
+    }
+    else if( findSubString( dataBuffer, "Device Priority (" ) == 0 
+          && dataBuffer[ getStringLength( dataBuffer ) - 1 ] == ')' )
+    {
+        return CFG_DEVICE_PRIORITY_CODE;
+    }
+    else if( compareString( dataBuffer, "Device Service Order" ) == 0 )
+    {
+        return CFG_DEVICE_ORDER_CODE;
+    }
+    else if( compareString( dataBuffer, "Max In-Flight I/O" ) == 0 )
+    {
+        return CFG_MAX_IN_FLIGHT_CODE;
+    }
+    else if( compareString( dataBuffer, 
+                           "Interrupt Coalescing Window (msec)" ) == 0 )
+    {
+        return CFG_COALESCE_WINDOW_CODE;
+    }
+    else if( compareString( dataBuffer, "Interrupt Coalescing Count" ) == 0 )
+    {
+        return CFG_COALESCE_COUNT_CODE;
+    }
+    else if( compareString( dataBuffer, "MLFQ Levels" ) == 0 )
+    {
+        return CFG_MLFQ_LEVELS_CODE;
+    }
+    else if( findSubString( dataBuffer, "MLFQ Quantum (Level " ) == 0 
+          && dataBuffer[ getStringLength( dataBuffer ) - 1 ] == ')' )
+    {
+        return CFG_MLFQ_QUANTUM_CODE;
+    }
+    else if( compareString( dataBuffer, "MLFQ Boost Interval (cycles)" ) == 0 )
+    {
+        return CFG_MLFQ_BOOST_CODE;
+    }
+    else if( compareString( dataBuffer, 
+                              "CFS Minimum Granularity (msec)" ) == 0 )
+    {
+        return CFG_CFS_GRANULARITY_CODE;
+    }
+    else if( compareString( dataBuffer, "Lottery Seed" ) == 0 )
+    {
+        return CFG_LOTTERY_SEED_CODE;
+    }
+    else if( compareString( dataBuffer, 
+                                 "End Simulator Configuration File." ) == 0 )
+    {
+        return CFG_END_LINE_CODE;
+    }
 
     // return corrupt leader line error code
     return CFG_CORRUPT_PROMPT_ERR;
 }
 
+/*
+Name: getDeviceConfig
+Process: finds the per device entry of the device named in a 
+            "<leaderStart><device>)" leader line, 
+         adds an entry using the default channels and lowest priority 
+            if the device is new
+Function Input/Parameters: config leader line string (const char *), 
+                           leader text before the device name (const char *)
+Function Output/Parameters: pointer to config data structure (ConfigDataType *)
+                            with the device added if new
+Function Output/Returned: index of the device entry (int)
+Device Input/Device: none
+Device Output/Device: none
+Dependencies: getStringLength, getSubString, setStrToLowerCase, 
+              compareString, copyString
+*/
+int getDeviceConfig( ConfigDataType *configData, const char *dataBuffer, 
+                                                    const char *leaderStart )
+{
+    // initialize function/variables
+    char deviceName[ STD_STR_LEN ];
+    char lowerCaseDeviceName[ STD_STR_LEN ];
+    int index = 0;
+
+    // take the name between the leader start and the closing ')'
+        // function: getSubString, getStringLength, setStrToLowerCase
+    getSubString( deviceName, dataBuffer, getStringLength( leaderStart ), 
+                                         getStringLength( dataBuffer ) - 2 );
+    setStrToLowerCase( lowerCaseDeviceName, deviceName );
+
+    // find an earlier entry for the same device
+        // function: compareString
+    while( index < configData->deviceConfigCount 
+      && compareString( configData->deviceNames[ index ], 
+                                              lowerCaseDeviceName ) != 0 )
+    {
+        index++;
+    }
+
+    // add the device if it is new
+        // function: copyString
+    if( index == configData->deviceConfigCount )
+    {
+        copyString( configData->deviceNames[ index ], lowerCaseDeviceName );
+        configData->deviceChannelCounts[ index ] = -1;
+        configData->devicePriorities[ index ] = 0;
+        configData->deviceConfigCount++;
+    }
+
+    // return the entry index
+    return index;
+}
+
 /*
 Name: getLogToCode
 Process: concerts "log to" text to configuration data code
@@ -534,6 +829,90 @@ ConfigDataCodes getLogToCode( const char *lowerCaseLogToStr )
     return returnVal;
 }
 
+/*
+Name: getMLFQLevel
+Process: finds the queue level named in a "MLFQ Quantum (Level <n>)" 
+            leader line
+Function Input/Parameters: config leader line string (const char *)
+Function Output/Parameters: none
+Function Output/Returned: queue level, NOT_IN_USE if it is not a level 
+                             below MAX_MLFQ_LEVELS (int)
+Device Input/Device: none
+Device Output/Device: none
+Dependencies: getStringLength, getSubString, sscanf
+*/
+int getMLFQLevel( const char *dataBuffer )
+{
+    // initialize function/variables
+    const char LEADER_START[] = "MLFQ Quantum (Level ";
+    char levelString[ STD_STR_LEN ];
+    int level;
+
+    // take the level between the leader start and the closing ')'
+        // function: getSubString, getStringLength
+    getSubString( levelString, dataBuffer, getStringLength( LEADER_START ), 
+                                         getStringLength( dataBuffer ) - 2 );
+
+    // check for a level the scheduler can hold
+        // function: sscanf
+    if( sscanf( levelString, "%d", &level ) != 1 
+     || level < 0 || level >= MAX_MLFQ_LEVELS )
+    {
+        return NOT_IN_USE;
+    }
+
+    // return the level
+    return level;
+}
+
+/*
+Name: setDeviceChannels
+Process: stores the channel count of the device named in a 
+            "Device Channels (<device>)" leader line, 
+         a repeated device replaces its earlier count
+Function Input/Parameters: config leader line string (const char *), 
+                           channel count (int)
+Function Output/Parameters: pointer to config data structure (ConfigDataType *)
+                            with the device added or updated
+Function Output/Returned: none
+Device Input/Device: none
+Device Output/Device: none
+Dependencies: getDeviceConfig
+*/
+void setDeviceChannels( ConfigDataType *configData, const char *dataBuffer, 
+                                                                int channels )
+{
+    // initialize function/variables
+        // function: getDeviceConfig
+    int index = getDeviceConfig( configData, dataBuffer, "Device Channels (" );
+
+    configData->deviceChannelCounts[ index ] = channels;
+}
+
+/*
+Name: setDevicePriority
+Process: stores the interrupt priority of the device named in a 
+            "Device Priority (<device>)" leader line, 
+         a repeated device replaces its earlier priority
+Function Input/Parameters: config leader line string (const char *), 
+                           interrupt priority (int)
+Function Output/Parameters: pointer to config data structure (ConfigDataType *)
+                            with the device added or updated
+Function Output/Returned: none
+Device Input/Device: none
+Device Output/Device: none
+Dependencies: getDeviceConfig
+*/
+void setDevicePriority( ConfigDataType *configData, const char *dataBuffer, 
+                                                                int priority )
+{
+    // initialize function/variables
+        // function: getDeviceConfig
+    int index = getDeviceConfig( configData, dataBuffer, "Device Priority (" );
+
+    configData->devicePriorities[ index ] = priority;
+}
+
 /*
 Name: stripTrailingSpaces
 Process: removes trailing spaces from input config leader lines
@@ -601,14 +980,9 @@ bool valueInRange( int lineCode, int intVal,
 
         case CFG_CPU_SCHED_CODE:
 
-            // check for not finding one of the scheduling strings
-                // function: compareString
-            if( compareString( lowerCaseStringVal, "fcfs-n" ) != 0 
-             && compareString( lowerCaseStringVal, "sjf-n" ) != 0 
-             && compareString( lowerCaseStringVal, "srtf-p" ) != 0 
-             && compareString( lowerCaseStringVal, "fcfs-p" ) != 0 
-             && compareString( lowerCaseStringVal, "rr-p" ) != 0 
-              )
+            // check for not finding a scheduler with the name
+                // function: findSchedulerByName
+            if( findSchedulerByName( lowerCaseStringVal ) == NULL )
             {
                 // set Boolean result to false
                 result = false;
@@ -630,8 +1004,9 @@ bool valueInRange( int lineCode, int intVal,
             // break
             break;
 
-        // for memory display
+        // for memory display or virtual timer
         case CFG_MEM_DISPLAY_CODE:
+        case CFG_VIRTUAL_TIMER_CODE:
 
             // check for not finding either "on" of "off"
             if( compareString( lowerCaseStringVal, "on" ) != 0 
@@ -683,6 +1058,178 @@ bool valueInRange( int lineCode, int intVal,
             // break
             break;
 
+        // check for time dilation
+        case CFG_TIME_DILATION_CODE:
+
+            // check for time dilation limits exceeded
+            if( doubleVal < 0.001 || doubleVal > 100.00 )
+            {
+                // set Boolean result to false
+                result = false;
+            }
+
+            // break
+            break;
+
+        // check for timer spin slice
+        case CFG_SPIN_SLICE_CODE:
+
+            // check for spin slice limits exceeded
+            if( intVal < 0 || intVal > 1000000 )
+            {
+                // set Boolean result to false
+                result = false;
+            }
+
+            // break
+            break;
+
+        // check for device channels
+        case CFG_DEVICE_CHANNELS_CODE:
+        case CFG_DEVICE_CHANNEL_CODE:
+
+            // check for channel count limits exceeded, 0 is unlimited
+            if( intVal < 0 || intVal > 64 )
+            {
+                // set Boolean result to false
+                result = false;
+            }
+
+            // break
+            break;
+
+        // check for in-flight I/O cap
+        case CFG_MAX_IN_FLIGHT_CODE:
+
+            // check for cap limits exceeded, 0 is unlimited
+            if( intVal < 0 || intVal > 100000 )
+            {
+                // set Boolean result to false
+                result = false;
+            }
+
+            // break
+            break;
+
+        // check for interrupt coalescing window
+        case CFG_COALESCE_WINDOW_CODE:
+
+            // check for window limits exceeded, 0 is off
+            if( intVal < 0 || intVal > 10000 )
+            {
+                // set Boolean result to false
+                result = false;
+            }
+
+            // break
+            break;
+
+        // check for completions per coalesced interrupt
+        case CFG_COALESCE_COUNT_CODE:
+
+            // check for count limits exceeded, 0 is unlimited
+            if( intVal < 0 || intVal > 100000 )
+            {
+                // set Boolean result to false
+                result = false;
+            }
+
+            // break
+            break;
+
+        // check for mlfq queue levels
+        case CFG_MLFQ_LEVELS_CODE:
+
+            // check for level count limits exceeded
+            if( intVal < 1 || intVal > MAX_MLFQ_LEVELS )
+            {
+                // set Boolean result to false
+                result = false;
+            }
+
+            // break
+            break;
+
+        // check for mlfq level quantum
+        case CFG_MLFQ_QUANTUM_CODE:
+
+            // check for quantum cycles limits exceeded
+            if( intVal < 1 || intVal > 100 )
+            {
+                // set Boolean result to false
+                result = false;
+            }
+
+            // break
+            break;
+
+        // check for mlfq priority boost interval
+        case CFG_MLFQ_BOOST_CODE:
+
+            // check for boost interval limits exceeded, 0 is off
+            if( intVal < 0 || intVal > 100000 )
+            {
+                // set Boolean result to false
+                result = false;
+            }
+
+            // break
+            break;
+
+        // check for cfs minimum granularity
+        case CFG_CFS_GRANULARITY_CODE:
+
+            // check for granularity msec limits exceeded
+            if( intVal < 1 || intVal > 10000 )
+            {
+                // set Boolean result to false
+                result = false;
+            }
+
+            // break
+            break;
+
+        // check for lottery seed
+        case CFG_LOTTERY_SEED_CODE:
+
+            // check for seed limits exceeded
+            if( intVal < 0 || intVal > 1000000000 )
+            {
+                // set Boolean result to false
+                result = false;
+            }
+
+            // break
+            break;
+
+        // check for device interrupt priority
+        case CFG_DEVICE_PRIORITY_CODE:
+
+            // check for priority limits exceeded, 0 is the lowest
+            if( intVal < 0 || intVal > MAX_INTERRUPT_PRIORITY )
+            {
+                // set Boolean result to false
+                result = false;
+            }
+
+            // break
+            break;
+
+        // check for device service order
+        case CFG_DEVICE_ORDER_CODE:
+
+            // check for not finding one of the service order strings
+                // fucntion: compareString
+            if( compareString( lowerCaseStringVal, "fifo" ) != 0 
+             && compareString( lowerCaseStringVal, "sjf" ) != 0 )
+            {
+                // set Boolean result to false
+                result = false;
+            }
+
+            // break
+            break;
+
         // check for log to operation
         case CFG_LOG_TO_CODE:
 
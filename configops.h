@@ -8,6 +8,9 @@ Provided by Dr. Michael Leverington NAU CS480 Fall2023
 #include "StandardConstants.h"
 #include "StringUtils.h"
 #include "datatypes.h"
+#include "simtimer.h"
+#include "interruptops.h"
+#include "schedops.h"
 
 
 
@@ -92,11 +95,31 @@ Function Output/Parameters: none
 Function Output/Returned: cpu schedule code (ConfigDataCodes)
 Device Input/Device: none
 Device Output/Device: none
-Dependencies: compareString
+Dependencies: findSchedulerByName
 */
 ConfigDataCodes getCpuSchedCode( const char *lowerCaseStr );
 
 
+/*
+Name: getDeviceConfig
+Process: finds the per device entry of the device named in a 
+            "<leaderStart><device>)" leader line, 
+         adds an entry using the default channels and lowest priority 
+            if the device is new
+Function Input/Parameters: config leader line string (const char *), 
+                           leader text before the device name (const char *)
+Function Output/Parameters: pointer to config data structure (ConfigDataType *)
+                            with the device added if new
+Function Output/Returned: index of the device entry (int)
+Device Input/Device: none
+Device Output/Device: none
+Dependencies: getStringLength, getSubString, setStrToLowerCase, 
+              compareString, copyString
+*/
+int getDeviceConfig( ConfigDataType *configData, const char *dataBuffer, 
+                                                    const char *leaderStart );
+
+
 /*
 Name: getLogToCode
 Process: concerts "log to" text to configuration data code
@@ -111,6 +134,57 @@ Dependencies: tbd
 ConfigDataCodes getLogToCode( const char *lowerCaseLogToStr );
 
 
+/*
+Name: getMLFQLevel
+Process: finds the queue level named in a "MLFQ Quantum (Level <n>)" 
+            leader line
+Function Input/Parameters: config leader line string (const char *)
+Function Output/Parameters: none
+Function Output/Returned: queue level, NOT_IN_USE if it is not a level 
+                             below MAX_MLFQ_LEVELS (int)
+Device Input/Device: none
+Device Output/Device: none
+Dependencies: getStringLength, getSubString, sscanf
+*/
+int getMLFQLevel( const char *dataBuffer );
+
+
+/*
+Name: setDeviceChannels
+Process: stores the channel count of the device named in a 
+            "Device Channels (<device>)" leader line, 
+         a repeated device replaces its earlier count
+Function Input/Parameters: config leader line string (const char *), 
+                           channel count (int)
+Function Output/Parameters: pointer to config data structure (ConfigDataType *)
+                            with the device added or updated
+Function Output/Returned: none
+Device Input/Device: none
+Device Output/Device: none
+Dependencies: getDeviceConfig
+*/
+void setDeviceChannels( ConfigDataType *configData, const char *dataBuffer, 
+                                                                int channels );
+
+
+/*
+Name: setDevicePriority
+Process: stores the interrupt priority of the device named in a 
+            "Device Priority (<device>)" leader line, 
+         a repeated device replaces its earlier priority
+Function Input/Parameters: config leader line string (const char *), 
+                           interrupt priority (int)
+Function Output/Parameters: pointer to config data structure (ConfigDataType *)
+                            with the device added or updated
+Function Output/Returned: none
+Device Input/Device: none
+Device Output/Device: none
+Dependencies: getDeviceConfig
+*/
+void setDevicePriority( ConfigDataType *configData, const char *dataBuffer, 
+                                                                int priority );
+
+
 /*
 Name: stripTrailingSpaces
 Process: removes trailing spaces from input config leader lines
@@ -14,6 +14,15 @@ Provided by Dr. Michael Leverington NAU CS480 Fall2023
 // GLOBAL CONSTANTS - may be used in other files
 #define NOT_IN_USE -1
 
+// per device channel counts that may be set in the config file
+#define MAX_DEVICE_CONFIGS 8
+
+// queue levels the mlfq-p scheduler may be configured with
+#define MAX_MLFQ_LEVELS 8
+
+// cpu share of an app whose app start line does not give one
+#define DEFAULT_APP_SHARE 1
+
 typedef enum { CMB_STR_LEN = 5, 
                IO_ARG_STR_LEN = 5, 
                STR_ARG_LEN = 15 
@@ -24,7 +33,8 @@ typedef enum { NEW_STATE,
                READY_STATE, 
                RUNNING_STATE, 
                BLOCKED_STATE, 
-               EXIT_STATE
+               EXIT_STATE, 
+               PROCESS_STATE_COUNT
              } ProcessState;
 
 typedef enum { CFG_FILE_ACCESS_ERR, 
@@ -40,7 +50,23 @@ typedef enum { CFG_FILE_ACCESS_ERR,
                CFG_PROC_CYCLES_CODE, 
                CFG_IO_CYCLES_CODE, 
                CFG_LOG_TO_CODE, 
-               CFG_LOG_FILE_NAME_CODE
+               CFG_LOG_FILE_NAME_CODE, 
+               CFG_VIRTUAL_TIMER_CODE, 
+               CFG_SPIN_SLICE_CODE, 
+               CFG_TIME_DILATION_CODE, 
+               CFG_DEVICE_CHANNELS_CODE, 
+               CFG_DEVICE_CHANNEL_CODE, 
+               CFG_DEVICE_ORDER_CODE, 
+               CFG_MAX_IN_FLIGHT_CODE, 
+               CFG_COALESCE_WINDOW_CODE, 
+               CFG_COALESCE_COUNT_CODE, 
+               CFG_DEVICE_PRIORITY_CODE, 
+               CFG_MLFQ_LEVELS_CODE, 
+               CFG_MLFQ_QUANTUM_CODE, 
+               CFG_MLFQ_BOOST_CODE, 
+               CFG_CFS_GRANULARITY_CODE, 
+               CFG_LOTTERY_SEED_CODE, 
+               CFG_END_LINE_CODE
              } ConfigCodeMessages;
 
 typedef enum { CPU_SCHED_SJF_N_CODE, 
@@ -52,7 +78,14 @@ typedef enum { CPU_SCHED_SJF_N_CODE,
                LOGTO_FILE_CODE, 
                LOGTO_BOTH_CODE, 
                NON_PREEMPTIVE_CODE, 
-               PREEMPTIVE_CODE 
+               PREEMPTIVE_CODE, 
+               DEVICE_ORDER_FIFO_CODE, 
+               DEVICE_ORDER_SJF_CODE, 
+               CPU_SCHED_MLFQ_P_CODE, 
+               CPU_SCHED_CFS_P_CODE, 
+               CPU_SCHED_STRIDE_P_CODE, 
+               CPU_SCHED_LOTTERY_P_CODE, 
+               CPU_SCHED_EDF_P_CODE 
              } ConfigDataCodes;
 
 typedef struct ConfigDataTypeStruct
@@ -67,12 +100,30 @@ typedef struct ConfigDataTypeStruct
     int ioCycleRate;
     int logToCode; // see configCodeToString
     char logToFileName[ MAX_STR_LEN ];
+    bool virtualTimer; // optional, defaults to off
+    bool diagnosticStats; // set by -ds only, defaults to off
+    int spinSliceUSec; // optional, defaults to DEFAULT_SPIN_SLICE_USEC
+    double timeDilation; // optional, defaults to DEFAULT_TIME_DILATION
+    int deviceChannels; // optional, channels per device, 0 is unlimited
+    int deviceServiceOrder; // optional, defaults to DEVICE_ORDER_FIFO_CODE
+    int deviceConfigCount; // optional per device channels and priorities
+    char deviceNames[ MAX_DEVICE_CONFIGS ][ STD_STR_LEN ];
+    int deviceChannelCounts[ MAX_DEVICE_CONFIGS ]; // -1 uses deviceChannels
+    int devicePriorities[ MAX_DEVICE_CONFIGS ]; // defaults to 0, the lowest
+    int maxInFlightIO; // optional, cap on admitted I/O, 0 is unlimited
+    int coalesceWindowMSec; // optional, interrupt coalescing, 0 is off
+    int coalesceCount; // optional, completions per interrupt, 0 is unlimited
+    int mlfqLevels; // optional, defaults to DEFAULT_MLFQ_LEVELS
+    int mlfqQuanta[ MAX_MLFQ_LEVELS ]; // optional, 0 doubles per level
+    int mlfqBoostCycles; // optional, cycles between boosts, 0 is off
+    int cfsGranularityMSec; // optional, least msec run before a switch
+    int lotterySeed; // optional, seeds the lottery-p ticket draws
 } ConfigDataType;
 
 typedef struct OpCodeTypeStruct
 {
     int pid;
-    int intArg2, intArg3;
+    int intArg2, intArg3, intArg4;
     struct OpCodeTypeStruct *nextNode;
     double opEndTime;
     char command[ MAX_STR_LEN ];
@@ -97,6 +148,7 @@ typedef struct PCBStateStruct
 
 
 struct MemorySegmentType;
+struct TimerContextStruct;
 struct PCBManagerType;
 struct ProcessTableType;
 struct PCBType;
@@ -132,17 +184,136 @@ typedef struct PCBType
     int completedProgramCycles;
     int consecutiveCycles;
     int remainingTotalTime;
-    char state[ STD_STR_LEN ];
+    ProcessState state;
+
+    // simulated usec the process first became ready, for turnaround
+    long arrivalTime;
 
     struct PCBType *prev, *next;
+
+    // looped list of the processes sharing this state, in pid order, 
+    //    a sorted insert, not O(1), so fcfs and rr can select by pid
+    struct PCBType *statePrev, *stateNext;
+
+    // links, level, and cycles run at that level in a scheduler's 
+    //    run queues, owned by the policy
+    struct PCBType *queuePrev, *queueNext;
+    int queueLevel;
+    int queueCycles;
+
+    // the manager whose state lists this process joins, 
+    //    and its position in a scheduler's ready heap, -1 while not in one
+    struct PCBManager *manager;
+    int heapIndex;
+
+    // msec run on the cpu, adjusted on wakeup by the cfs-p scheduler, 
+    //    and the process's links in that scheduler's red-black run tree
+    long vruntime;
+    struct PCBType *treeParent, *treeLeft, *treeRight;
+    bool treeRed;
+
+    // share (tickets) from the app start line, 
+    //    and the pass value the stride-p scheduler orders processes by
+    int shareTickets;
+    long passValue;
+
+    // relative deadline msec from the app start line, 0 for none, 
+    //    and the simulated usec it falls due, set once the process arrives
+    int relativeDeadline;
+    long deadlineTime;
 } PCBType;
 
+// binary min-heap of ready and running processes, 
+//    before returns if the first process belongs ahead of the second
+typedef struct ReadyHeapType
+{
+    PCBType **nodes;
+    int count;
+    int capacity;
+    bool (*before)( PCBType *first, PCBType *second );
+} ReadyHeapType;
+
+// red-black tree of processes ordered by virtual runtime, then pid, 
+//    linked through the processes themselves
+typedef struct RunTreeType
+{
+    PCBType *root;
+    int count;
+} RunTreeType;
+
+struct SchedulerStruct;
+
+// scheduling policy hooks, one set per policy, see schedops.h
+typedef struct SchedulerOpsStruct
+{
+    // config file name of the policy, and its config code
+    const char *name;
+    ConfigDataCodes schedCode;
+
+    // preemptive policies send I/O to the interrupt manager
+    bool preemptive;
+
+    // create and free the policy's private data
+    void (*init)( struct SchedulerStruct *scheduler );
+    void (*clear)( struct SchedulerStruct *scheduler );
+
+    // a process becomes ready or running, or stops being either
+    void (*enqueue)( struct SchedulerStruct *scheduler, PCBType *pcb );
+    void (*dequeue)( struct SchedulerStruct *scheduler, PCBType *pcb );
+
+    // returns the process to run next, NULL if none can run
+    PCBType *(*pickNext)( struct SchedulerStruct *scheduler );
+
+    // a cycle of the running process ended, returns if its slice ended
+    bool (*onTick)( struct SchedulerStruct *scheduler, PCBType *pcb );
+
+    // the running process blocked for an I/O operation
+    void (*onBlock)( struct SchedulerStruct *scheduler, PCBType *pcb );
+
+    // an interrupt made processes ready while current runs, 
+    //    returns if current should give up the cpu now
+    bool (*shouldPreempt)( struct SchedulerStruct *scheduler, 
+                                                        PCBType *current );
+
+    // displays the policy's own statistics at the end of the run
+    void (*report)( struct SchedulerStruct *scheduler );
+} SchedulerOpsType;
+
+typedef struct SchedulerStruct
+{
+    const SchedulerOpsType *ops;
+    struct PCBManager *manager;
+    ConfigDataType *configPtr;
+
+    // owned by the policy, created by init and freed by clear
+    void *policyData;
+
+    // running processes that gave up the cpu to a ready process
+    int preemptionCount;
+} SchedulerType;
+
 typedef struct PCBManager
 {
     PCBType *pcbHead;
+    SchedulerType *scheduler;
+
+    // per state process lists and their live counts
+    PCBType *stateHeads[ PROCESS_STATE_COUNT ];
+    int stateCounts[ PROCESS_STATE_COUNT ];
+
+    // summed arrival to exit time of every exited process
+    long totalTurnaroundUSec;
+
+    // exited processes with deadlines, those that missed them, 
+    //    and their summed and worst lateness
+    int deadlineCount, deadlineMissCount;
+    long totalLatenessUSec, maxLatenessUSec;
+
     ConfigDataType *configPtr;
     int unusedPid;
     struct MemorySegmentType *memory;
+    struct TimerContextStruct *timer;
+    struct OutputFormatStruct *outputFormat;
 
     PCBType *currentPcb;
 } PCBManagerType;
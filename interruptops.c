@@ -5,46 +5,237 @@ InterruptManager is a data structure that manages interrupts.
 InterruptManager can be safely managed at any time using: 
  - createInterruptManager: construct the manager - required first
  - clearInterruptManager: destruct the manager - required last
- - sendProcessToInterrupt: creates a thread that runs the process
- - getInterruptProcess: returns a process whose thread ended
+ - sendProcessToInterrupt: schedules the process to complete later
+ - getInterruptProcess: returns a process whose operation completed
+ - queueSubmission, submitOperations: batch form of sendProcessToInterrupt
+ - reapCompletions: batch form of getInterruptProcess
+ - drainInterrupts: takes every completed operation at once, 
+      sorted by priority then completion time, 
+      for getBatchProcess to hand out
+ - collectInterrupts: merges newly completed operations into a batch
  - isEmpty: returns if there are no processes waiting to be popped
- - waitingForProcesses: returns if threads are still running
+ - waitingForProcesses: returns if operations are still pending
+ - idleUntilInterrupt: waits for the next interrupt when the cpu is idle
+ - interruptDue: returns if the cpu should take an interrupt now
+
+Pending operations are held in a hierarchical timing wheel keyed by the
+   simulated millisecond they complete in. Each tick expires one slot of
+   the first level into the ready queue; higher levels hold later
+   completions and are cascaded down one slot at a time as the first
+   level wraps. Inserting and expiring an operation take constant time
+   apart from ordering the operations that share a tick.
+In real time mode a single I/O worker thread, started with the manager 
+   and joined when it is cleared, advances the wheel as time passes: it 
+   waits out the next tick and expires it, sleeping on workerCond while 
+   nothing is pending. In virtual time mode the wheel is advanced to the 
+   simulated clock whenever the queue is checked, and the idle cpu jumps 
+   the clock to the next completion.
+Each operation is served by the device named in its dev op. A device 
+   has a fixed number of channels from the config, 0 for unlimited; 
+   requests beyond that wait in the device's queue, in FIFO or shortest 
+   first order, and start when a channel frees at its completion time. 
+   Wait and latency per device are reported by displayDeviceStats.
+The config may also cap the operations admitted at once, across all 
+   devices. Operations sent past the cap park in the submission queue 
+   and are admitted in order as admitted operations complete. 
+   displayAdmissionStats reports how many parked and for how long.
+Completions may be coalesced: with a window set in the config, the 
+   completions ready within the window of the oldest one, or up to the 
+   configured count of them, are delivered as a single interrupt. 
+   interruptDue and drainInterrupts hold them back until then.
+Each device has an interrupt priority from the config. Completions are 
+   serviced highest priority first, and collectInterrupts merges new 
+   completions into the batch being serviced, so a higher priority one 
+   preempts lower ones still waiting. displayPriorityStats reports the 
+   service latency of each priority class.
+Operations may be submitted in batches through the submission ring: 
+   queueSubmission fills a slot of the fixed-size ring without a lock, 
+   and submitOperations takes queueLock once to admit every queued 
+   operation. Completions are reaped in batches by reapCompletions from 
+   the lock-free ready queue. sendProcessToInterrupt and 
+   getInterruptProcess are the single operation forms of the two.
+Interrupt nodes are recycled through the manager's node pool rather 
+   than freed, so once the pool has grown to the peak number of nodes in 
+   use, sending and completing operations makes no heap allocations.
 */
 
 /*
 queueLock is used to prevent race conditions allowing multiple sources
           to modify data at the same time. 
 the queue is locked when: 
- - the number of processes being threaded is modified
- - nodes are being removed from the queue
- - nodes are being added to the queu
-multiple sources can access data from the queue at the same time, 
-   as long as it is not used to identify parts of the queue to be modified
+ - the number of pending operations is modified
+ - nodes are being added to or removed from the wheel
+ - the idle cpu checks for nodes before sleeping on readyCond
+ - queued submissions are taken from the submission ring
+the ready queue itself needs no lock to pop: every push is made by 
+   completeOperation while queueLock is held, and only the cpu thread 
+   pops. pushes exchange the tail atomically, then link the old tail to 
+   the new node, so a pop never waits on the lock. readyCount, 
+   pendingOperations and the wheel's nextDueTick are read with atomic 
+   loads, without the lock
+
 */
 
 /*
 at any time outside of a critical section:
  - there must be no reference to any node bewteen the queue's start and tail
     to be accessed later
- - the value of runningThreads must be greater than or equal to the number of 
-    threads that could modify the queue
+ - the value of pendingOperations must be equal to the number of
+    operations held in the wheel, waiting in a device queue 
+    or parked in the submission queue
+ - the value of inFlight must be equal to the number of operations 
+    admitted and not yet complete, never above a nonzero maxInFlight
+ - the value of readyCount must be at least the number of nodes that 
+    popInterrupt can return, a push is counted once it is linked
 */
 
 
+/*
+Name: admitOperation
+Process: admits a node at admitTime, counting it in flight, 
+         records how long it waited for admission, 
+         starts it at its device if a channel is free, 
+            otherwise queues it at the device
+note: requires queueLock to be held by the caller
+*/
+void admitOperation( InterruptManager *manager, InterruptNode *node, 
+                                                              long admitTime )
+{
+    DeviceQueue *device = node->device;
+    long admitWaitUSec = admitTime - node->submitTime;
+
+    manager->inFlight++;
+    manager->totalAdmitWaitUSec += admitWaitUSec;
+    if( admitWaitUSec > manager->maxAdmitWaitUSec )
+    {
+        manager->maxAdmitWaitUSec = admitWaitUSec;
+    }
+
+    // the device sees the request once it is admitted
+    node->requestTime = admitTime;
+    device->requestCount++;
+
+    // start now if a channel is free, otherwise wait at the device
+    if( device->channels == 0 || device->busyChannels < device->channels )
+    {
+        startDeviceService( manager, node, admitTime );
+    }
+    else
+    {
+        queueDeviceRequest( manager, node );
+    }
+}
+
+/*
+Name: advanceWheel
+Process: expires every wheel tick up to the simulated time nowTicks, 
+         moving the nodes due in each tick onto the ready queue
+         and decrementing the count of pending operations for each, 
+         cascades higher levels down as the first level wraps
+note: requires queueLock to be held by the caller
+*/
+void advanceWheel( InterruptManager *manager, long nowTicks )
+{
+    TimingWheel *wheel = &manager->pendingWheel;
+    InterruptNode *slotNode, *nextNode;
+    long tick;
+    int level, slot;
+
+    // an empty wheel has nothing to expire, 
+    //    skip straight to the tick after now
+    if( manager->pendingOperations == 0 )
+    {
+        if( wheel->currentTick <= nowTicks / 1000 )
+        {
+            wheel->currentTick = nowTicks / 1000 + 1;
+        }
+        return;
+    }
+
+    // expire one tick at a time until the wheel is past now
+    while( wheel->currentTick * 1000 <= nowTicks )
+    {
+        tick = wheel->currentTick;
+
+        // each time a level wraps to slot zero, 
+        //    bring the next slot of the level above down into the wheel
+        level = 1;
+        while( level < WHEEL_LEVELS && 
+               ( ( tick >> ( WHEEL_SLOT_BITS * ( level - 1 ) ) ) 
+                                              & ( WHEEL_SLOTS - 1 ) ) == 0 )
+        {
+            slot = ( tick >> ( WHEEL_SLOT_BITS * level ) ) 
+                                                     & ( WHEEL_SLOTS - 1 );
+            slotNode = wheel->slots[ level ][ slot ];
+            wheel->slots[ level ][ slot ] = NULL;
+
+            // nodes are never due before tick here, 
+            //    so each lands in a lower level of the wheel
+            while( slotNode != NULL )
+            {
+                nextNode = slotNode->next;
+                if( !insertWheelNode( manager, slotNode ) )
+                {
+                    completeOperation( manager, slotNode );
+                }
+                slotNode = nextNode;
+            }
+
+            level++;
+        }
+
+        // every node in this tick's first level slot is due, 
+        //    a freed channel may start a request due in this same tick, 
+        //    so take the slot again until it stays empty
+        slot = tick & ( WHEEL_SLOTS - 1 );
+        while( wheel->slots[ 0 ][ slot ] != NULL )
+        {
+            slotNode = wheel->slots[ 0 ][ slot ];
+            wheel->slots[ 0 ][ slot ] = NULL;
+
+            // slot is sorted, complete in order
+            while( slotNode != NULL )
+            {
+                nextNode = slotNode->next;
+                completeOperation( manager, slotNode );
+                slotNode = nextNode;
+            }
+        }
+
+        wheel->currentTick++;
+    }
+
+    // the ticks passed may have held the next due node, find the next
+    if( wheel->nextDueTick < wheel->currentTick )
+    {
+        findNextDueTick( wheel );
+    }
+}
+
 /*
 Name: clearInterruptNode
-Process: clear memory for the node
+Process: returns the node to the manager's node pool
 */
-InterruptNode *clearInterruptNode( InterruptNode *node )
+InterruptNode *clearInterruptNode( InterruptManager *manager, 
+                                                        InterruptNode *node )
 {
-    free( node );
+    NodePool *pool = &manager->nodePool;
+
+    pthread_mutex_lock( &pool->poolLock );
+
+    node->next = pool->freeList;
+    pool->freeList = node;
+    pool->freeCount++;
+
+    pthread_mutex_unlock( &pool->poolLock );
     return NULL;
 }
 
 /*
 Name: clearInterruptManager
-Process: waits for all threads to end, 
-         clears all nodes, 
+Process: waits for all pending operations to complete, 
+         clears all nodes, including the node pool, 
+         stops and joins the I/O worker, 
          clears memory for self
 note: this will wait until all interrupts have completed 
       their time before ending
@@ -52,28 +243,221 @@ note: this will wait until all interrupts have completed
 InterruptManager *clearInterruptManager( InterruptManager *manager )
 {
     PCBType *interruptProcess;
+    DeviceQueue *device;
+    InterruptNode *freeNode;
 
     while( !isEmpty( manager ) || waitingForProcesses( manager ) )
     {
+        idleUntilInterrupt( manager );
         interruptProcess = getInterruptProcess( manager );
         clearPCBNode( interruptProcess );
     }
 
+    // wake the worker so it sees the stop request
+    pthread_mutex_lock( &manager->queueLock );
+    manager->stopWorker = true;
+    pthread_cond_signal( &manager->workerCond );
+    pthread_mutex_unlock( &manager->queueLock );
+
+    if( manager->workerStarted )
+    {
+        pthread_join( manager->ioWorker, NULL );
+    }
+
+    // device queues are empty once nothing is pending
+    while( manager->deviceList != NULL )
+    {
+        device = manager->deviceList;
+        manager->deviceList = device->next;
+        free( device );
+    }
+
+    // every node is back in the pool once nothing is pending
+    while( manager->nodePool.freeList != NULL )
+    {
+        freeNode = manager->nodePool.freeList;
+        manager->nodePool.freeList = freeNode->next;
+        free( freeNode );
+    }
+    pthread_mutex_destroy( &manager->nodePool.poolLock );
+
+    pthread_cond_destroy( &manager->workerCond );
+    pthread_cond_destroy( &manager->readyCond );
+    pthread_mutex_destroy( &manager->queueLock );
     free( manager );
     return NULL;
 }
 
+/*
+Name: coalescedReadyTime
+Process: returns the simulated time the ready completions are due 
+            to the cpu, -1 if none are ready
+         without a coalescing window, or once coalesceCount are ready 
+            or nothing else is pending, that of the oldest one, 
+         otherwise the end of the oldest one's window
+note: only the cpu thread may call this
+*/
+long coalescedReadyTime( InterruptManager *manager )
+{
+    InterruptNode *oldestNode = peekInterrupt( manager );
+
+    if( oldestNode == NULL )
+    {
+        return -1;
+    }
+
+    // nothing more can join the interrupt, deliver it now
+    if( manager->coalesceWindowUSec == 0 
+     || ( manager->coalesceCount > 0 
+          && __atomic_load_n( &manager->readyCount, __ATOMIC_SEQ_CST ) 
+                                                  >= manager->coalesceCount )
+     || !waitingForProcesses( manager ) )
+    {
+        return oldestNode->dueTime;
+    }
+
+    return oldestNode->dueTime + manager->coalesceWindowUSec;
+}
+
+/*
+Name: collectInterrupts
+Process: drains newly completed nodes and merges them into batch, 
+            keeping it in service order, 
+         a higher priority completion goes ahead of lower ones 
+            already waiting in the batch
+note: only the cpu thread may call this
+*/
+void collectInterrupts( InterruptManager *manager, InterruptNode **batch )
+{
+    InterruptNode *drainedNode = drainInterrupts( manager );
+    InterruptNode *nextNode, **wkgLink = batch;
+
+    // both lists are in service order, so each insert continues 
+    //    from where the last one was placed
+    while( drainedNode != NULL )
+    {
+        nextNode = drainedNode->next;
+
+        while( *wkgLink != NULL && !servicedBefore( drainedNode, *wkgLink ) )
+        {
+            wkgLink = &(*wkgLink)->next;
+        }
+        drainedNode->next = *wkgLink;
+        *wkgLink = drainedNode;
+        wkgLink = &drainedNode->next;
+
+        drainedNode = nextNode;
+    }
+}
+
+/*
+Name: completesBefore
+Process: returns if the first node completes before the second, 
+         by dueTime, then by the order the two were sent
+*/
+bool completesBefore( InterruptNode *first, InterruptNode *second )
+{
+    return first->dueTime < second->dueTime 
+           || ( first->dueTime == second->dueTime 
+                                        && first->sequence < second->sequence );
+}
+
+/*
+Name: completeOperation
+Process: moves a node whose service has ended onto the ready queue, 
+         decrements the count of pending operations, 
+         frees its device channel, starting the next queued request 
+            at the moment this one completed, 
+         frees its in-flight slot, admitting the next parked operation 
+            at the same moment
+note: requires queueLock to be held by the caller
+*/
+void completeOperation( InterruptManager *manager, InterruptNode *node )
+{
+    DeviceQueue *device = node->device;
+    long completeTime = node->dueTime;
+    InterruptNode *waitingNode;
+
+    // node may be popped and freed as soon as it is pushed, 
+    //    so everything needed from it is read first
+    device->totalLatencyUSec += completeTime - node->requestTime;
+    pushInterruptLocked( manager, node );
+    __atomic_sub_fetch( &manager->pendingOperations, 1, __ATOMIC_SEQ_CST );
+
+    device->busyChannels--;
+
+    // hand the channel to the next waiting request
+    if( device->waitStart != NULL )
+    {
+        waitingNode = device->waitStart;
+        device->waitStart = waitingNode->next;
+        if( device->waitStart == NULL )
+        {
+            device->waitTail = NULL;
+        }
+
+        startDeviceService( manager, waitingNode, completeTime );
+    }
+
+    // hand the in-flight slot to the next parked operation
+    manager->inFlight--;
+    if( manager->submitStart != NULL )
+    {
+        waitingNode = manager->submitStart;
+        manager->submitStart = waitingNode->next;
+        if( manager->submitStart == NULL )
+        {
+            manager->submitTail = NULL;
+        }
+        manager->submitDepth--;
+
+        admitOperation( manager, waitingNode, completeTime );
+    }
+}
+
 /*
 Name: createInterruptNode
-Process: allocate memory for data structure, 
+Process: takes a node from the manager's node pool, 
+            allocating one only if the pool is empty, 
          sets process as a reference to the pcbRef
 */
-InterruptNode *createInterruptNode( PCBType *pcbRef )
+InterruptNode *createInterruptNode( InterruptManager *manager, 
+                                                            PCBType *pcbRef )
 {
-    InterruptNode *newNode = (InterruptNode *)malloc( sizeof( InterruptNode ) );
+    NodePool *pool = &manager->nodePool;
+    InterruptNode *newNode;
+
+    pthread_mutex_lock( &pool->poolLock );
+
+    // reuse a returned node if there is one
+    newNode = pool->freeList;
+    if( newNode != NULL )
+    {
+        pool->freeList = newNode->next;
+        pool->freeCount--;
+        pool->hits++;
+    }
+    else
+    {
+        pool->misses++;
+    }
+
+    pthread_mutex_unlock( &pool->poolLock );
+
+    // the pool only grows while more nodes are in use than ever before
+    if( newNode == NULL )
+    {
+        newNode = (InterruptNode *)malloc( sizeof( InterruptNode ) );
+    }
 
     newNode->process = pcbRef;
+    newNode->dueTime = 0;
+    newNode->sequence = 0;
     newNode->next = NULL;
+    newNode->device = NULL;
+    newNode->submitTime = 0;
+    newNode->requestTime = 0;
+    newNode->serviceUSec = 0;
 
     return newNode;
 }
@@ -81,21 +465,539 @@ InterruptNode *createInterruptNode( PCBType *pcbRef )
 /*
 Name: create interrupt manager
 Process: allocates memory to the data structure, 
-         initializes as an empty queue, 
+         initializes as an empty queue and empty wheel, 
          initialize mutex, used to prevent race conditions
+         interrupts are timed with the simulation's timer, 
+         stats are logged to the simulation's output, 
+         devices are served as the config sets, 
+         in real time mode, starts the I/O worker
 */
-InterruptManager *createInterruptManager()
+InterruptManager *createInterruptManager( TimerContextType *timer, 
+                                          OutputFormatType *outputFormat, 
+                                                   ConfigDataType *configPtr )
 {
+    int level, slot, index;
     InterruptManager *manager = (InterruptManager *)malloc( 
                                                    sizeof( InterruptManager ) );
-    manager->readyQueueStart = NULL;
-    manager->readyQueueTail = NULL;
+    // the ready queue starts holding only the stub
+    manager->readyStub.next = NULL;
+    manager->readyQueueStart = &manager->readyStub;
+    manager->readyQueueTail = &manager->readyStub;
+    manager->readyCount = 0;
+
+    manager->timer = timer;
+    manager->outputFormat = outputFormat;
+    manager->deviceList = NULL;
+    manager->config = configPtr;
+
+    manager->maxInFlight = configPtr->maxInFlightIO;
+    manager->inFlight = 0;
+    manager->submitStart = NULL;
+    manager->submitTail = NULL;
+    manager->submitDepth = 0;
+    manager->parkedCount = 0;
+    manager->maxSubmitDepth = 0;
+    manager->totalAdmitWaitUSec = 0;
+    manager->maxAdmitWaitUSec = 0;
+
+    manager->coalesceWindowUSec = (long)configPtr->coalesceWindowMSec * 1000;
+    manager->coalesceCount = configPtr->coalesceCount;
+
+    for( index = 0; index < INTERRUPT_PRIORITY_CLASSES; index++ )
+    {
+        manager->priorityStats[ index ].interruptCount = 0;
+        manager->priorityStats[ index ].totalLatencyUSec = 0;
+        manager->priorityStats[ index ].maxLatencyUSec = 0;
+    }
+
+    manager->submitRing.head = 0;
+    manager->submitRing.tail = 0;
+
+    manager->nodePool.freeList = NULL;
+    manager->nodePool.freeCount = 0;
+    manager->nodePool.hits = 0;
+    manager->nodePool.misses = 0;
+    pthread_mutex_init( &manager->nodePool.poolLock, NULL );
     pthread_mutex_init( &manager->queueLock, NULL );
-    manager->runningThreads = 0;
+    manager->pendingOperations = 0;
+    pthread_cond_init( &manager->readyCond, NULL );
+
+    for( level = 0; level < WHEEL_LEVELS; level++ )
+    {
+        for( slot = 0; slot < WHEEL_SLOTS; slot++ )
+        {
+            manager->pendingWheel.slots[ level ][ slot ] = NULL;
+        }
+    }
+    manager->pendingWheel.currentTick = 0;
+    manager->pendingWheel.nextDueTick = 0;
+    manager->pendingWheel.nextSequence = 0;
+
+    // virtual time is advanced by the caller, no worker is needed
+    pthread_cond_init( &manager->workerCond, NULL );
+    manager->stopWorker = false;
+    manager->workerStarted = !usingVirtualTime( timer );
+    if( manager->workerStarted )
+    {
+        pthread_create( &manager->ioWorker, NULL, 
+                                             ioWorkerThread, (void *)manager );
+    }
     
     return manager;
 }
 
+/*
+Name: displayAdmissionStats
+Process: outputs the in-flight cap, the operations that parked, 
+            the deepest the submission queue got and the admission wait, 
+         outputs nothing if there is no cap
+*/
+void displayAdmissionStats( InterruptManager *manager )
+{
+    char outputString[ HUGE_STR_LEN ];
+    long averageWait = 0;
+
+    if( manager->maxInFlight == 0 )
+    {
+        return;
+    }
+
+    pthread_mutex_lock( &manager->queueLock );
+
+    if( manager->parkedCount > 0 )
+    {
+        averageWait = manager->totalAdmitWaitUSec / manager->parkedCount;
+    }
+
+    snprintf( outputString, HUGE_STR_LEN, 
+              "I/O admission: cap %d in flight, %d parked, max depth %d, "
+              "wait avg %ld usec, max %ld usec\n", 
+              manager->maxInFlight, manager->parkedCount, 
+              manager->maxSubmitDepth, averageWait, 
+              manager->maxAdmitWaitUSec );
+    outputDirectly( manager->outputFormat, outputString );
+
+    pthread_mutex_unlock( &manager->queueLock );
+}
+
+/*
+Name: displayDeviceStats
+Process: outputs one line per device used, 
+         with its channels, requests, queue wait and latency, 
+         outputs nothing if no channels or service order are configured
+*/
+void displayDeviceStats( InterruptManager *manager )
+{
+    DeviceQueue *device;
+    char outputString[ HUGE_STR_LEN ];
+    char channelString[ MIN_STR_LEN ];
+
+    if( manager->config->deviceChannels == 0 
+             && manager->config->deviceConfigCount == 0 
+             && manager->config->deviceServiceOrder == DEVICE_ORDER_FIFO_CODE )
+    {
+        return;
+    }
+
+    pthread_mutex_lock( &manager->queueLock );
+
+    for( device = manager->deviceList; device != NULL; 
+                                                       device = device->next )
+    {
+        if( device->channels == 0 )
+        {
+            copyString( channelString, "unlimited" );
+        }
+        else
+        {
+            sprintf( channelString, "%d", device->channels );
+        }
+
+        snprintf( outputString, HUGE_STR_LEN, 
+                  "Device %s: %s channels, %d requests, %d queued, "
+                  "wait avg %ld usec, max %ld usec, latency avg %ld usec\n", 
+                  device->name, channelString, device->requestCount, 
+                  device->queuedCount, 
+                  device->totalWaitUSec / device->requestCount, 
+                  device->maxWaitUSec, 
+                  device->totalLatencyUSec / device->requestCount );
+        outputDirectly( manager->outputFormat, outputString );
+    }
+
+    pthread_mutex_unlock( &manager->queueLock );
+}
+
+/*
+Name: displayNodePoolStats
+Process: outputs the node pool hits, misses and free nodes, 
+         outputs nothing unless diagnostic stats are on (-ds) 
+            or if no node was ever taken
+*/
+void displayNodePoolStats( InterruptManager *manager )
+{
+    NodePool *pool = &manager->nodePool;
+    char outputString[ HUGE_STR_LEN ];
+
+    if( !manager->config->diagnosticStats )
+    {
+        return;
+    }
+
+    pthread_mutex_lock( &pool->poolLock );
+
+    if( pool->hits + pool->misses > 0 )
+    {
+        snprintf( outputString, HUGE_STR_LEN, 
+                  "Interrupt node pool: %ld hits, %ld misses, %d free\n", 
+                  pool->hits, pool->misses, pool->freeCount );
+        outputDirectly( manager->outputFormat, outputString );
+    }
+
+    pthread_mutex_unlock( &pool->poolLock );
+}
+
+/*
+Name: displayPriorityStats
+Process: outputs one line per priority class with serviced interrupts, 
+            with the count and the latency from completion to service, 
+         outputs nothing if every interrupt had the lowest priority
+*/
+void displayPriorityStats( InterruptManager *manager )
+{
+    PriorityClassStats *classStats;
+    char outputString[ HUGE_STR_LEN ];
+    int priority, raisedInterrupts = 0;
+
+    for( priority = 1; priority < INTERRUPT_PRIORITY_CLASSES; priority++ )
+    {
+        raisedInterrupts += manager->priorityStats[ priority ].interruptCount;
+    }
+
+    if( raisedInterrupts == 0 )
+    {
+        return;
+    }
+
+    // highest priority first, the order they are serviced in
+    for( priority = MAX_INTERRUPT_PRIORITY; priority >= 0; priority-- )
+    {
+        classStats = &manager->priorityStats[ priority ];
+
+        if( classStats->interruptCount > 0 )
+        {
+            snprintf( outputString, HUGE_STR_LEN, 
+                      "Interrupt priority %d: %d interrupts, "
+                      "latency avg %ld usec, max %ld usec\n", 
+                      priority, classStats->interruptCount, 
+                      classStats->totalLatencyUSec 
+                                             / classStats->interruptCount, 
+                      classStats->maxLatencyUSec );
+            outputDirectly( manager->outputFormat, outputString );
+        }
+    }
+}
+
+/*
+Name: drainInterrupts
+Process: pops every completed node from the ready queue in one pass, 
+         returns them as a list in service order, by servicedBefore, 
+            NULL if none are ready
+         when coalescing, returns NULL until an interrupt is due, 
+            then only the nodes within the window of the oldest, 
+            at most coalesceCount of them
+         the caller takes them off the list with getBatchProcess
+note: only the cpu thread may call this
+*/
+InterruptNode *drainInterrupts( InterruptManager *manager )
+{
+    InterruptNode *batchStart = NULL, *batchTail = NULL;
+    InterruptNode *poppedNode, *nextNode, **wkgLink;
+    long windowEnd = 0;
+    int drainedCount = 0;
+
+    // coalesced completions wait until their interrupt is due
+    if( manager->coalesceWindowUSec > 0 && !interruptDue( manager ) )
+    {
+        return NULL;
+    }
+
+    poppedNode = popInterrupt( manager );
+    if( poppedNode != NULL )
+    {
+        windowEnd = poppedNode->dueTime + manager->coalesceWindowUSec;
+    }
+
+    while( poppedNode != NULL )
+    {
+        // nodes usually arrive in order, append if not before the tail
+        if( batchTail == NULL || !servicedBefore( poppedNode, batchTail ) )
+        {
+            poppedNode->next = NULL;
+            if( batchTail == NULL )
+            {
+                batchStart = poppedNode;
+            }
+            else
+            {
+                batchTail->next = poppedNode;
+            }
+            batchTail = poppedNode;
+        }
+
+        // otherwise, insert it in service order
+        else
+        {
+            wkgLink = &batchStart;
+            while( !servicedBefore( poppedNode, *wkgLink ) )
+            {
+                wkgLink = &(*wkgLink)->next;
+            }
+            poppedNode->next = *wkgLink;
+            *wkgLink = poppedNode;
+        }
+        drainedCount++;
+
+        // a coalesced interrupt ends at its count or the end of its window, 
+        //    later completions are left for the next one
+        nextNode = peekInterrupt( manager );
+        if( ( manager->coalesceCount > 0 
+                                  && drainedCount >= manager->coalesceCount )
+         || ( manager->coalesceWindowUSec > 0 && nextNode != NULL 
+                                       && nextNode->dueTime > windowEnd ) )
+        {
+            poppedNode = NULL;
+        }
+        else
+        {
+            poppedNode = popInterrupt( manager );
+        }
+    }
+
+    return batchStart;
+}
+
+/*
+Name: enqueueReadyNode
+Process: links a node onto the tail of the lock-free ready queue, 
+         does not count or signal it, used for the stub as well
+*/
+void enqueueReadyNode( InterruptManager *manager, InterruptNode *toPush )
+{
+    InterruptNode *previousTail;
+
+    __atomic_store_n( &toPush->next, NULL, __ATOMIC_RELAXED );
+
+    // claim the tail, producers are ordered by this exchange
+    previousTail = __atomic_exchange_n( &manager->readyQueueTail, toPush, 
+                                                           __ATOMIC_ACQ_REL );
+
+    // then make the node reachable from the old tail
+    __atomic_store_n( &previousTail->next, toPush, __ATOMIC_RELEASE );
+}
+
+/*
+Name: findNextDueTick
+Process: sets nextDueTick to the first tick from currentTick whose first 
+            level slot holds a node, 
+         stops at the next first level wrap, where a higher level may 
+            cascade nodes down
+note: requires queueLock to be held by the caller
+*/
+void findNextDueTick( TimingWheel *wheel )
+{
+    long tick = wheel->currentTick;
+
+    while( ( tick & ( WHEEL_SLOTS - 1 ) ) != 0 
+        && wheel->slots[ 0 ][ tick & ( WHEEL_SLOTS - 1 ) ] == NULL )
+    {
+        tick++;
+    }
+
+    __atomic_store_n( &wheel->nextDueTick, tick, __ATOMIC_RELEASE );
+}
+
+/*
+Name: flushSubmitRing
+Process: takes every queued entry from the submission ring, 
+         for each, brings the wheel up to its submit time, 
+            creates its node and admits or parks it, 
+            as sendProcessToInterrupt describes, 
+         returns the number of entries taken
+note: requires queueLock to be held by the caller
+*/
+int flushSubmitRing( InterruptManager *manager )
+{
+    SubmitRing *ring = &manager->submitRing;
+    SubmitEntry *entry;
+    InterruptNode *pendingNode;
+    long ringTail;
+    int takenCount = 0;
+
+    // entries up to the tail are fully written once the tail is seen
+    ringTail = __atomic_load_n( &ring->tail, __ATOMIC_ACQUIRE );
+
+    while( ring->head != ringTail )
+    {
+        entry = &ring->entries[ ring->head & ( SUBMIT_RING_SLOTS - 1 ) ];
+        pendingNode = createInterruptNode( manager, entry->process );
+
+        // bring the wheel up to the submit time so the node is placed 
+        //    relative to it
+        advanceWheel( manager, entry->submitTime );
+
+        pendingNode->device = getDeviceQueue( manager, entry->deviceName );
+        pendingNode->submitTime = entry->submitTime;
+        pendingNode->serviceUSec = (long)entry->processTime * 1000;
+        pendingNode->sequence = manager->pendingWheel.nextSequence++;
+
+        // counted before it can complete
+        __atomic_add_fetch( &manager->pendingOperations, 1, 
+                                                        __ATOMIC_SEQ_CST );
+
+        // admit now if under the cap, otherwise park until a slot frees
+        if( manager->maxInFlight == 0 
+                               || manager->inFlight < manager->maxInFlight )
+        {
+            admitOperation( manager, pendingNode, entry->submitTime );
+        }
+        else
+        {
+            pendingNode->next = NULL;
+            if( manager->submitTail == NULL )
+            {
+                manager->submitStart = pendingNode;
+            }
+            else
+            {
+                manager->submitTail->next = pendingNode;
+            }
+            manager->submitTail = pendingNode;
+
+            manager->parkedCount++;
+            manager->submitDepth++;
+            if( manager->submitDepth > manager->maxSubmitDepth )
+            {
+                manager->maxSubmitDepth = manager->submitDepth;
+            }
+        }
+
+        // the slot may be reused once head has passed it
+        __atomic_store_n( &ring->head, ring->head + 1, __ATOMIC_RELEASE );
+        takenCount++;
+    }
+
+    return takenCount;
+}
+
+/*
+Name: getDeviceQueue
+Process: returns the queue of the named device, 
+         creating it with the config's channel count and priority 
+            on first use
+note: requires queueLock to be held by the caller
+*/
+DeviceQueue *getDeviceQueue( InterruptManager *manager, char *deviceName )
+{
+    DeviceQueue *device, *wkgDevice;
+    char lowerCaseName[ STD_STR_LEN ];
+    int index;
+
+    setStrToLowerCase( lowerCaseName, deviceName );
+
+    // few devices are used, a list is searched quickly
+    for( device = manager->deviceList; device != NULL; 
+                                                       device = device->next )
+    {
+        if( compareString( device->name, lowerCaseName ) == 0 )
+        {
+            return device;
+        }
+    }
+
+    device = (DeviceQueue *)malloc( sizeof( DeviceQueue ) );
+    copyString( device->name, lowerCaseName );
+
+    // a device listed in the config may override the default channel 
+    //    count, and may raise its priority above the lowest
+    device->channels = manager->config->deviceChannels;
+    device->priority = 0;
+    for( index = 0; index < manager->config->deviceConfigCount; index++ )
+    {
+        if( compareString( manager->config->deviceNames[ index ], 
+                                                      lowerCaseName ) == 0 )
+        {
+            if( manager->config->deviceChannelCounts[ index ] >= 0 )
+            {
+                device->channels = 
+                               manager->config->deviceChannelCounts[ index ];
+            }
+            device->priority = manager->config->devicePriorities[ index ];
+        }
+    }
+
+    device->busyChannels = 0;
+    device->waitStart = NULL;
+    device->waitTail = NULL;
+    device->requestCount = 0;
+    device->queuedCount = 0;
+    device->totalWaitUSec = 0;
+    device->maxWaitUSec = 0;
+    device->totalLatencyUSec = 0;
+
+    // keep devices in the order first used, for reporting
+    device->next = NULL;
+    if( manager->deviceList == NULL )
+    {
+        manager->deviceList = device;
+    }
+    else
+    {
+        wkgDevice = manager->deviceList;
+        while( wkgDevice->next != NULL )
+        {
+            wkgDevice = wkgDevice->next;
+        }
+        wkgDevice->next = device;
+    }
+
+    return device;
+}
+
+/*
+Name: getBatchProcess
+Process: removes the first node from a drained batch, 
+         records its latency in its priority class, 
+         returns the node to the manager's node pool, 
+         returns its process, NULL if the batch is empty
+*/
+PCBType *getBatchProcess( InterruptManager *manager, InterruptNode **batch )
+{
+    InterruptNode *batchNode = *batch;
+    PriorityClassStats *classStats;
+    PCBType *batchProcess;
+    long latency;
+
+    if( batchNode == NULL )
+    {
+        return NULL;
+    }
+
+    // the operation completed at dueTime, it is serviced now
+    classStats = &manager->priorityStats[ batchNode->device->priority ];
+    latency = getTimerTicks( manager->timer ) - batchNode->dueTime;
+    classStats->interruptCount++;
+    classStats->totalLatencyUSec += latency;
+    if( latency > classStats->maxLatencyUSec )
+    {
+        classStats->maxLatencyUSec = latency;
+    }
+
+    *batch = batchNode->next;
+    batchProcess = batchNode->process;
+    clearInterruptNode( manager, batchNode );
+    return batchProcess;
+}
+
 /*
 Name: getInterruptProcess
 Process: pops an interrupt from the queue, if exists, 
@@ -105,45 +1007,225 @@ Process: pops an interrupt from the queue, if exists,
 PCBType *getInterruptProcess( InterruptManager *manager )
 {
     PCBType *poppedProcess;
-    InterruptNode *poppedNode = popInterrupt( manager );
-    if( poppedNode == NULL )
+
+    if( reapCompletions( manager, &poppedProcess, 1 ) == 0 )
     {
         return NULL;
     }
-    poppedProcess = poppedNode->process;
-    clearInterruptNode( poppedNode );
     return poppedProcess;
 }
 
 /*
-Name: isEmpty
-Process: returns if there are completed processes stored in the manager
+Name: idleUntilInterrupt
+Process: called while the cpu is idle, 
+         in virtual time mode, advances the simulated clock to the 
+            completion time of the next pending interrupt
+         in real time mode, sleeps on readyCond until a node reaches 
+            the ready queue or nothing is left pending
+         when coalescing, also waits until the interrupt is due
 */
-bool isEmpty( InterruptManager *manager )
+void idleUntilInterrupt( InterruptManager *manager )
 {
-    // if start is NULL, list is empty
-    return manager->readyQueueStart == NULL;
+    long readyTime, nextTickTime;
+
+    // the clock only needs to be moved if no interrupt is due yet
+    if( usingVirtualTime( manager->timer ) && !interruptDue( manager ) )
+    {
+        pthread_mutex_lock( &manager->queueLock );
+
+        // expire ticks one at a time until something completes
+        while( peekInterrupt( manager ) == NULL 
+                                         && manager->pendingOperations > 0 )
+        {
+            advanceWheel( manager, manager->pendingWheel.currentTick * 1000 );
+        }
+
+        // while coalescing, keep expiring ticks until the window of the 
+        //    first released node closes or enough have completed
+        while( manager->coalesceWindowUSec > 0 
+            && peekInterrupt( manager ) != NULL 
+            && coalescedReadyTime( manager ) 
+                                >= manager->pendingWheel.currentTick * 1000 )
+        {
+            advanceWheel( manager, manager->pendingWheel.currentTick * 1000 );
+        }
+
+        // jump to the completion time of the first released node
+        if( peekInterrupt( manager ) != NULL )
+        {
+            setVirtualTime( manager->timer, 
+                            peekInterrupt( manager )->dueTime );
+
+            // a coalesced interrupt is due once its window closes, 
+            //    and no earlier than the last completion it holds
+            if( manager->coalesceWindowUSec > 0 )
+            {
+                setVirtualTime( manager->timer, 
+                                coalescedReadyTime( manager ) );
+                setVirtualTime( manager->timer, 
+                                manager->readyQueueTail->dueTime );
+            }
+        }
+
+        pthread_mutex_unlock( &manager->queueLock );
+    }
+
+    // real time: sleep until the worker releases a node, 
+    //    pushes are made holding queueLock, so none is missed
+    else if( !usingVirtualTime( manager->timer ) )
+    {
+        pthread_mutex_lock( &manager->queueLock );
+
+        // nothing pending means nothing will arrive, do not wait
+        while( isEmpty( manager ) && waitingForProcesses( manager ) )
+        {
+            pthread_cond_wait( &manager->readyCond, &manager->queueLock );
+        }
+
+        // a coalesced interrupt may still be open, wait it out a tick 
+        //    at a time so reaching the count ends the wait early
+        while( !isEmpty( manager ) && !interruptDue( manager ) )
+        {
+            readyTime = coalescedReadyTime( manager );
+            nextTickTime = getTimerTicks( manager->timer ) + 1000;
+            pthread_mutex_unlock( &manager->queueLock );
+
+            runTimerUntil( manager->timer, readyTime < nextTickTime 
+                                                ? readyTime : nextTickTime );
+
+            pthread_mutex_lock( &manager->queueLock );
+        }
+
+        pthread_mutex_unlock( &manager->queueLock );
+    }
 }
 
 /*
-Name: modify running threads
-Process: modify the number of running threads. 
-         this is the only function that modifies 
-            runningThreads after initialization
-         queueLock prevents runningThreads from being modified by 
-            multiple calls at the same time. 
+Name: insertWheelNode
+Process: places a node in the wheel slot for its dueTime, 
+            the first level holds the next WHEEL_SLOTS ticks, 
+            each higher level holds a WHEEL_SLOTS times longer span
+         returns if the node was placed in the wheel, 
+            false if it is already due
+note: requires queueLock to be held by the caller
 */
-void modifyRunningThreads( InterruptManager *manager, int modifier )
+bool insertWheelNode( InterruptManager *manager, InterruptNode *toInsert )
 {
-    // when modifying runningThreads, 
-    //    lock other sources out of the critical section
+    TimingWheel *wheel = &manager->pendingWheel;
+    InterruptNode **wkgLink;
+    long dueTick, delta;
+    int level = 0, slot;
+
+    // a node is due in the first tick at or after its dueTime
+    dueTick = ( toInsert->dueTime + 999 ) / 1000;
+
+    // ticks before currentTick have already expired
+    if( dueTick < wheel->currentTick )
+    {
+        return false;
+    }
+
+    // find the lowest level whose span reaches the due tick, 
+    //    anything beyond the top level is cascaded again later
+    delta = dueTick - wheel->currentTick;
+    while( level < WHEEL_LEVELS - 1 
+                   && delta >= 1L << ( WHEEL_SLOT_BITS * ( level + 1 ) ) )
+    {
+        level++;
+    }
+    slot = ( dueTick >> ( WHEEL_SLOT_BITS * level ) ) & ( WHEEL_SLOTS - 1 );
+
+    // the cpu must take the lock once this node is due
+    if( dueTick < wheel->nextDueTick )
+    {
+        __atomic_store_n( &wheel->nextDueTick, dueTick, __ATOMIC_RELEASE );
+    }
+
+    // keep the slot sorted, equal dueTimes in the order they were sent
+    wkgLink = &wheel->slots[ level ][ slot ];
+    while( *wkgLink != NULL && completesBefore( *wkgLink, toInsert ) )
+    {
+        wkgLink = &(*wkgLink)->next;
+    }
+
+    toInsert->next = *wkgLink;
+    *wkgLink = toInsert;
+    return true;
+}
+
+/*
+Name: interruptDue
+Process: returns if the cpu should take an interrupt now, 
+            without a coalescing window, if any completion is ready, 
+            otherwise once coalescedReadyTime has passed
+note: only the cpu thread may call this, 
+      without holding queueLock in virtual time mode
+*/
+bool interruptDue( InterruptManager *manager )
+{
+    long readyTime;
+
+    if( manager->coalesceWindowUSec == 0 )
+    {
+        return !isEmpty( manager );
+    }
+
+    // move any completed operations to the ready queue
+    releaseDueInterrupts( manager );
+
+    readyTime = coalescedReadyTime( manager );
+    return readyTime >= 0 && readyTime <= getTimerTicks( manager->timer );
+}
+
+/*
+Name: ioWorkerThread
+Process: real time mode only, the I/O worker, 
+         sleeps until the wheel holds a node, 
+         then waits out the next tick and advances the wheel to the timer, 
+         ends when stopWorker is set
+*/
+void *ioWorkerThread( void *voidManager )
+{
+    InterruptManager *manager = (InterruptManager *)voidManager;
+    long nextTickTime;
+
     pthread_mutex_lock( &manager->queueLock );
 
-    // modify runningThreads when in critical section
-    manager->runningThreads += modifier;
+    while( !manager->stopWorker )
+    {
+        // nothing pending, sleep until an operation is submitted
+        if( manager->pendingOperations == 0 )
+        {
+            pthread_cond_wait( &manager->workerCond, &manager->queueLock );
+        }
+        else
+        {
+            // wait for the next tick without holding the lock
+            nextTickTime = manager->pendingWheel.currentTick * 1000;
+            pthread_mutex_unlock( &manager->queueLock );
+
+            runTimerUntil( manager->timer, nextTickTime );
+
+            pthread_mutex_lock( &manager->queueLock );
+            advanceWheel( manager, getTimerTicks( manager->timer ) );
+        }
+    }
 
-    // modification complete, allow other sources to modify runningThreads
     pthread_mutex_unlock( &manager->queueLock );
+    return NULL;
+}
+
+/*
+Name: isEmpty
+Process: returns if there are completed processes stored in the manager, 
+         an atomic load of readyCount
+*/
+bool isEmpty( InterruptManager *manager )
+{
+    // move any completed operations to the ready queue
+    releaseDueInterrupts( manager );
+
+    return __atomic_load_n( &manager->readyCount, __ATOMIC_SEQ_CST ) == 0;
 }
 
 /*
@@ -151,126 +1233,344 @@ Name: popInterrupt
 Process: selects the node at the start of the queue, 
          if it exists, moves the start to the next node, 
             and returns the popped node. 
-         if the queue is empty, returns NULL
-         uses queueLock to prevent other sources from modifying the 
-            queue at the same time
+         if the queue is empty, returns NULL, 
+            also NULL while the only node is still being linked by a push
+note: only the cpu thread may call this, without holding queueLock
 */
 InterruptNode *popInterrupt( InterruptManager *manager )
 {
-    InterruptNode *poppedNode;
+    InterruptNode *poppedNode, *nextNode;
 
-    // prevent other sources from modifying the queue 
-    //    while changes are being made
-    pthread_mutex_lock( &manager->queueLock );
+    // move any completed operations to the ready queue
+    releaseDueInterrupts( manager );
 
-    // select the first node to be removed
     poppedNode = manager->readyQueueStart;
+    nextNode = __atomic_load_n( &poppedNode->next, __ATOMIC_ACQUIRE );
 
-    // if the node doesn't exist, return access to the queue and exit
-    if( poppedNode == NULL )
+    // skip over the stub, it is never returned
+    if( poppedNode == &manager->readyStub )
     {
-        pthread_mutex_unlock( &manager->queueLock );
-        return NULL;
+        // nothing follows the stub, the queue is empty
+        if( nextNode == NULL )
+        {
+            return NULL;
+        }
+
+        manager->readyQueueStart = nextNode;
+        poppedNode = nextNode;
+        nextNode = __atomic_load_n( &poppedNode->next, __ATOMIC_ACQUIRE );
     }
-    // otherwise, the node does exist
 
-    // remove the node from the queue by setting start to the next item
-    manager->readyQueueStart = manager->readyQueueStart->next;
-    if( manager->readyQueueStart == NULL )
+    // the last node can only be taken once something is linked behind it, 
+    //    requeue the stub if no push is part way through
+    if( nextNode == NULL )
     {
-        // update tail if the last node was removed
-        manager->readyQueueTail = NULL;
+        // a push has claimed the tail but not linked it yet, try later
+        if( poppedNode != __atomic_load_n( &manager->readyQueueTail, 
+                                                           __ATOMIC_ACQUIRE ) )
+        {
+            return NULL;
+        }
+
+        enqueueReadyNode( manager, &manager->readyStub );
+        nextNode = __atomic_load_n( &poppedNode->next, __ATOMIC_ACQUIRE );
+
+        // another push got in between, its link is not visible yet
+        if( nextNode == NULL )
+        {
+            return NULL;
+        }
     }
 
-    // done modifying queueLock, return access to other sources
-    pthread_mutex_unlock( &manager->queueLock );
-    
+    // move the start past the popped node
+    manager->readyQueueStart = nextNode;
+    __atomic_sub_fetch( &manager->readyCount, 1, __ATOMIC_SEQ_CST );
+
     // poppedNode is no longer accessible from queue: 
     //   safe to reference outside of critical section
     return poppedNode;
 }
 
 /*
-Name: pushInterrupt
-Process: pushes a node onto the tail
-         updates tail, and start if necessary
-         uses queueLock to prevent other sources from modifying 
-            the queue at the same time
+Name: peekInterrupt
+Process: returns the node popInterrupt would return next, 
+            NULL if the queue is empty, 
+         does not remove it
+note: only the cpu thread may call this
 */
-void pushInterrupt( InterruptManager *manager, InterruptNode *toPush )
+InterruptNode *peekInterrupt( InterruptManager *manager )
 {
-    // prevent other sources from modifying the queue
-    pthread_mutex_lock( &manager->queueLock );
+    InterruptNode *startNode = manager->readyQueueStart;
 
-    // if empty, start and tail have the same value
-    if( manager->readyQueueTail == NULL )
+    if( startNode == &manager->readyStub )
     {
-        manager->readyQueueStart = toPush;
-        manager->readyQueueTail = toPush;
+        return __atomic_load_n( &startNode->next, __ATOMIC_ACQUIRE );
     }
-    // otherwise, not empty: store the value after the tail, 
-    //   update the tail to include the new node
+
+    return startNode;
+}
+
+/*
+Name: pushInterruptLocked
+Process: pushes a node onto the tail of the ready queue, 
+         counts it in readyCount, 
+         wakes the idle cpu
+note: requires queueLock to be held by the caller
+*/
+void pushInterruptLocked( InterruptManager *manager, InterruptNode *toPush )
+{
+    enqueueReadyNode( manager, toPush );
+    __atomic_add_fetch( &manager->readyCount, 1, __ATOMIC_SEQ_CST );
+
+    // the idle cpu may be waiting for this node
+    pthread_cond_signal( &manager->readyCond );
+}
+
+/*
+Name: queueDeviceRequest
+Process: adds a node to its device's wait queue, 
+            at the tail in FIFO order, 
+            before any longer request in SJF order
+note: requires queueLock to be held by the caller
+*/
+void queueDeviceRequest( InterruptManager *manager, InterruptNode *node )
+{
+    DeviceQueue *device = node->device;
+    InterruptNode **wkgLink;
+
+    device->queuedCount++;
+    node->next = NULL;
+
+    // shortest first: stop at the first longer request, 
+    //    equal requests keep the order they were sent
+    if( manager->config->deviceServiceOrder == DEVICE_ORDER_SJF_CODE )
+    {
+        wkgLink = &device->waitStart;
+        while( *wkgLink != NULL 
+                           && (*wkgLink)->serviceUSec <= node->serviceUSec )
+        {
+            wkgLink = &(*wkgLink)->next;
+        }
+
+        node->next = *wkgLink;
+        *wkgLink = node;
+        if( node->next == NULL )
+        {
+            device->waitTail = node;
+        }
+    }
+
+    // FIFO: append at the tail
     else
     {
-        manager->readyQueueTail->next = toPush;
-        manager->readyQueueTail = toPush;
+        if( device->waitTail == NULL )
+        {
+            device->waitStart = node;
+        }
+        else
+        {
+            device->waitTail->next = node;
+        }
+        device->waitTail = node;
     }
+}
 
-    // changes complete, allow other sources to modify the queue
+/*
+Name: queueSubmission
+Process: queues an operation needing processTime at the named device 
+            in the submission ring, stamped with the current time, 
+            without taking a lock, 
+         returns false if the ring is full, 
+         the manager does not see it until submitOperations
+note: only the cpu thread may call this
+*/
+bool queueSubmission( InterruptManager *manager, PCBType *process, 
+                                       int processTime, char *deviceName )
+{
+    SubmitRing *ring = &manager->submitRing;
+    SubmitEntry *entry;
+
+    // only this thread moves tail, head is moved by whoever flushes
+    if( ring->tail - __atomic_load_n( &ring->head, __ATOMIC_ACQUIRE ) 
+                                                        >= SUBMIT_RING_SLOTS )
+    {
+        return false;
+    }
+
+    entry = &ring->entries[ ring->tail & ( SUBMIT_RING_SLOTS - 1 ) ];
+    entry->process = process;
+    entry->processTime = processTime;
+    entry->deviceName = deviceName;
+    entry->submitTime = getTimerTicks( manager->timer );
+
+    // publish the entry, it is complete before the new tail is seen
+    __atomic_store_n( &ring->tail, ring->tail + 1, __ATOMIC_RELEASE );
+    return true;
+}
+
+/*
+Name: reapCompletions
+Process: pops up to maxCount completed nodes from the ready queue, 
+            in the order popInterrupt returns them, 
+         stores their processes in processes, returns each node 
+            to the node pool, 
+         returns the number reaped
+note: only the cpu thread may call this
+*/
+int reapCompletions( InterruptManager *manager, PCBType **processes, 
+                                                              int maxCount )
+{
+    InterruptNode *poppedNode;
+    int reapedCount = 0;
+
+    while( reapedCount < maxCount )
+    {
+        poppedNode = popInterrupt( manager );
+        if( poppedNode == NULL )
+        {
+            return reapedCount;
+        }
+
+        processes[ reapedCount ] = poppedNode->process;
+        clearInterruptNode( manager, poppedNode );
+        reapedCount++;
+    }
+
+    return reapedCount;
+}
+
+/*
+Name: releaseDueInterrupts
+Process: in virtual time mode, advances the wheel to the simulated clock, 
+            moving every completed node onto the ready queue, 
+         takes queueLock only if a node may be due
+         in real time mode the I/O worker does this, does nothing
+*/
+void releaseDueInterrupts( InterruptManager *manager )
+{
+    if( !usingVirtualTime( manager->timer ) )
+    {
+        return;
+    }
+
+    // nothing pending, or nothing due yet, leaves the lock alone
+    if( __atomic_load_n( &manager->pendingOperations, __ATOMIC_SEQ_CST ) == 0 
+     || __atomic_load_n( &manager->pendingWheel.nextDueTick, 
+                              __ATOMIC_ACQUIRE ) * 1000 
+                                       > getVirtualTime( manager->timer ) )
+    {
+        return;
+    }
+
+    // prevent other sources from modifying the queues
+    pthread_mutex_lock( &manager->queueLock );
+
+    advanceWheel( manager, getVirtualTime( manager->timer ) );
+
+    // changes complete, allow other sources to modify the queues
     pthread_mutex_unlock( &manager->queueLock );
 }
 
 /*
 Name: sendProcessToInterrupt
-Process: create data structure to store thread arguments in, 
-         increment the number of threads running, 
-         create a thread to send the process to the interrupt manager
+Process: create a node needing processTime at the named device, 
+         admits it now if under the in-flight cap, 
+            otherwise parks it in the submission queue, 
+         increments the number of pending operations and wakes the worker, 
+         a one entry batch through queueSubmission and submitOperations
+note: only the cpu thread may call this
 */
 void sendProcessToInterrupt( InterruptManager *manager, PCBType *process, 
-                             int processTime )
+                             int processTime, char *deviceName )
 {
-    pthread_t tempId;
-    InterruptThreadArgs *threadArgs = (InterruptThreadArgs *)malloc( 
-                                                sizeof( InterruptThreadArgs ) );
-    threadArgs->manager = manager;
-    threadArgs->process = process;
-    threadArgs->processTime = processTime;
+    // a full ring is submitted first to make room
+    if( !queueSubmission( manager, process, processTime, deviceName ) )
+    {
+        submitOperations( manager );
+        queueSubmission( manager, process, processTime, deviceName );
+    }
 
-    modifyRunningThreads( manager, +1 );
+    submitOperations( manager );
+}
+
+/*
+Name: servicedBefore
+Process: returns if the first node is serviced before the second, 
+         by the priority of its device, then by completesBefore
+*/
+bool servicedBefore( InterruptNode *first, InterruptNode *second )
+{
+    if( first->device->priority != second->device->priority )
+    {
+        return first->device->priority > second->device->priority;
+    }
 
-    pthread_create( &tempId, NULL, sendProcessToInterruptThread, (void *)threadArgs );
+    return completesBefore( first, second );
 }
 
 /*
-Name: sendProcessToInterruptThread
-Process: store the process in an interruptNode, 
-         wait for the specified time, 
-         stores the node in the manager. 
-         After, decrement the count of running threads
+Name: startDeviceService
+Process: takes a channel of the node's device at startTime, 
+         records how long the request waited, 
+         stores the node in the wheel, due once its service time passes, 
+         completes it at once if already due
+note: requires queueLock to be held by the caller
 */
-void *sendProcessToInterruptThread( void *voidArgs )
+void startDeviceService( InterruptManager *manager, InterruptNode *node, 
+                                                              long startTime )
 {
-    InterruptThreadArgs *threadArgs = (InterruptThreadArgs *)voidArgs;
-    InterruptNode *nodeToPush;
-    nodeToPush = createInterruptNode( threadArgs->process );
+    DeviceQueue *device = node->device;
+    long waitUSec = startTime - node->requestTime;
 
-    runTimer( threadArgs->processTime );
-    pushInterrupt( threadArgs->manager, nodeToPush );
-    modifyRunningThreads( threadArgs->manager, -1 );
+    device->busyChannels++;
+    device->totalWaitUSec += waitUSec;
+    if( waitUSec > device->maxWaitUSec )
+    {
+        device->maxWaitUSec = waitUSec;
+    }
 
-    free( voidArgs );
-    return NULL;
+    node->dueTime = startTime + node->serviceUSec;
+
+    if( !insertWheelNode( manager, node ) )
+    {
+        completeOperation( manager, node );
+    }
 }
 
 /*
-Name: waitingForProcesses
-Process: returns if threads are being ran
+Name: submitOperations
+Process: submits every operation queued in the submission ring, 
+            taking queueLock once for the whole batch, 
+         wakes the worker if any were submitted, 
+         returns the number submitted
 */
-bool waitingForProcesses( InterruptManager *manager )
+int submitOperations( InterruptManager *manager )
 {
-    return manager->runningThreads > 0;
-}
+    int submittedCount;
 
+    // prevent other sources from modifying the wheel and devices
+    pthread_mutex_lock( &manager->queueLock );
+
+    submittedCount = flushSubmitRing( manager );
 
+    if( submittedCount > 0 )
+    {
+        pthread_cond_signal( &manager->workerCond );
+    }
 
+    // changes complete, allow other sources to modify the wheel
+    pthread_mutex_unlock( &manager->queueLock );
+
+    return submittedCount;
+}
 
+/*
+Name: waitingForProcesses
+Process: returns if operations are still pending, 
+         an atomic load of pendingOperations
+*/
+bool waitingForProcesses( InterruptManager *manager )
+{
+    return __atomic_load_n( &manager->pendingOperations, 
+                                                     __ATOMIC_SEQ_CST ) > 0;
+}
@@ -6,21 +6,79 @@ InterruptManager is a data structure that manages interrupts.
 InterruptManager can be safely managed at any time using: 
  - createInterruptManager: construct the manager - required first
  - clearInterruptManager: destruct the manager - required last
- - sendProcessToInterrupt: creates a thread that runs the process
- - getInterruptProcess: returns a process whose thread ended
+ - sendProcessToInterrupt: schedules the process to complete later
+ - getInterruptProcess: returns a process whose operation completed
+ - queueSubmission, submitOperations: batch form of sendProcessToInterrupt
+ - reapCompletions: batch form of getInterruptProcess
+ - drainInterrupts: takes every completed operation at once, 
+      sorted by priority then completion time, 
+      for getBatchProcess to hand out
+ - collectInterrupts: merges newly completed operations into a batch
  - isEmpty: returns if there are no processes waiting to be popped
- - waitingForProcesses: returns if threads are still running
+ - waitingForProcesses: returns if operations are still pending
+ - idleUntilInterrupt: waits for the next interrupt when the cpu is idle
+ - interruptDue: returns if the cpu should take an interrupt now
+ - displayDeviceStats: reports the wait and latency seen at each device
+ - displayAdmissionStats: reports operations parked by the in-flight cap
+ - displayNodePoolStats: reports how often the node pool avoided malloc
+
+Pending operations are held in a hierarchical timing wheel keyed by the
+   simulated millisecond they complete in. Each tick expires one slot of
+   the first level into the ready queue; higher levels hold later
+   completions and are cascaded down one slot at a time as the first
+   level wraps. Inserting and expiring an operation take constant time
+   apart from ordering the operations that share a tick.
+In real time mode a single I/O worker thread, started with the manager 
+   and joined when it is cleared, advances the wheel as time passes: it 
+   waits out the next tick and expires it, sleeping on workerCond while 
+   nothing is pending. In virtual time mode the wheel is advanced to the 
+   simulated clock whenever the queue is checked, and the idle cpu jumps 
+   the clock to the next completion.
+Each operation is served by the device named in its dev op. A device 
+   has a fixed number of channels from the config, 0 for unlimited; 
+   requests beyond that wait in the device's queue, in FIFO or shortest 
+   first order, and start when a channel frees at its completion time. 
+   Wait and latency per device are reported by displayDeviceStats.
+The config may also cap the operations admitted at once, across all 
+   devices. Operations sent past the cap park in the submission queue 
+   and are admitted in order as admitted operations complete. 
+   displayAdmissionStats reports how many parked and for how long.
+Completions may be coalesced: with a window set in the config, the 
+   completions ready within the window of the oldest one, or up to the 
+   configured count of them, are delivered as a single interrupt. 
+   interruptDue and drainInterrupts hold them back until then.
+Each device has an interrupt priority from the config. Completions are 
+   serviced highest priority first, and collectInterrupts merges new 
+   completions into the batch being serviced, so a higher priority one 
+   preempts lower ones still waiting. displayPriorityStats reports the 
+   service latency of each priority class.
+Operations may be submitted in batches through the submission ring: 
+   queueSubmission fills a slot of the fixed-size ring without a lock, 
+   and submitOperations takes queueLock once to admit every queued 
+   operation. Completions are reaped in batches by reapCompletions from 
+   the lock-free ready queue. sendProcessToInterrupt and 
+   getInterruptProcess are the single operation forms of the two.
+Interrupt nodes are recycled through the manager's node pool rather 
+   than freed, so once the pool has grown to the peak number of nodes in 
+   use, sending and completing operations makes no heap allocations.
 */
 
 /*
 queueLock is used to prevent race conditions allowing multiple sources
           to modify data at the same time. 
 the queue is locked when: 
- - the number of processes being threaded is modified
- - nodes are being removed from the queue
- - nodes are being added to the queu
-multiple sources can access data from the queue at the same time, 
-   as long as it is not used to identify parts of the queue to be modified
+ - the number of pending operations is modified
+ - nodes are being added to or removed from the wheel
+ - devices are created, or their channels or queues are modified
+ - operations are admitted, parked, or the admission counters change
+ - the idle cpu checks for nodes before sleeping on readyCond
+ - queued submissions are taken from the submission ring
+the ready queue itself needs no lock to pop: every push is made by 
+   completeOperation while queueLock is held, and only the cpu thread 
+   pops. pushes exchange the tail atomically, then link the old tail to 
+   the new node, so a pop never waits on the lock. readyCount, 
+   pendingOperations and the wheel's nextDueTick are read with atomic 
+   loads, without the lock
 
 */
 
@@ -28,71 +86,394 @@ multiple sources can access data from the queue at the same time,
 at any time outside of a critical section:
  - there must be no reference to any node bewteen the queue's start and tail
     to be accessed later
- - the value of runningThreads must be greater than or equal to the number of 
-    threads that could modify the queue
+ - the value of pendingOperations must be equal to the number of
+    operations held in the wheel, waiting in a device queue 
+    or parked in the submission queue
+ - the value of inFlight must be equal to the number of operations 
+    admitted and not yet complete, never above a nonzero maxInFlight
+ - the value of readyCount must be at least the number of nodes that 
+    popInterrupt can return, a push is counted once it is linked
 */
 
 
 #include "datatypes.h"
 #include "pcbops.h"
+#include "simtimer.h"
 #include<pthread.h>
 #include<stdbool.h>
 
+// device interrupt priorities, 0 is the lowest and the default
+#define MAX_INTERRUPT_PRIORITY 7
+#define INTERRUPT_PRIORITY_CLASSES ( MAX_INTERRUPT_PRIORITY + 1 )
+
+// slots in the submission ring, a power of two
+#define SUBMIT_RING_SLOTS 64
+
+// timing wheel geometry: one tick is one simulated millisecond, 
+//    each level covers WHEEL_SLOTS times the span of the level below
+#define WHEEL_LEVELS 4
+#define WHEEL_SLOT_BITS 8
+#define WHEEL_SLOTS ( 1 << WHEEL_SLOT_BITS )
+
 struct InterruptManager;
 struct InterruptNode;
+struct DeviceQueue;
 
 
-typedef struct InterruptManager
-{
-    struct InterruptNode *readyQueueStart;
-    struct InterruptNode *readyQueueTail;
-    pthread_mutex_t queueLock;
-    int runningThreads;
-} InterruptManager;
-
 typedef struct InterruptNode
 {
     PCBType *process;
+    long dueTime;
+    long sequence;
     struct InterruptNode *next;
+
+    // the device serving the operation, sent at submitTime, 
+    //    admitted to the device at requestTime, 
+    //    needing serviceUSec once started
+    struct DeviceQueue *device;
+    long submitTime;
+    long requestTime;
+    long serviceUSec;
 } InterruptNode;
 
-typedef struct InterruptThreadArgs
+// recycled interrupt nodes, guarded by poolLock
+typedef struct NodePool
+{
+    InterruptNode *freeList;
+    int freeCount;
+
+    // nodes taken from the free list, and nodes that had to be allocated
+    long hits;
+    long misses;
+
+    pthread_mutex_t poolLock;
+} NodePool;
+
+typedef struct DeviceQueue
+{
+    // lower case device name from the dev op
+    char name[ STD_STR_LEN ];
+
+    // channels serving at once, 0 is unlimited
+    int channels;
+    int busyChannels;
+
+    // interrupt priority of its completions, higher are serviced first
+    int priority;
+
+    // requests waiting for a channel, in service order
+    InterruptNode *waitStart;
+    InterruptNode *waitTail;
+
+    // requests made, those that had to wait, and the time they spent
+    int requestCount;
+    int queuedCount;
+    long totalWaitUSec;
+    long maxWaitUSec;
+    long totalLatencyUSec;
+
+    struct DeviceQueue *next;
+} DeviceQueue;
+
+// interrupts the cpu serviced in one priority class, 
+//    and how long each waited after its operation completed
+typedef struct PriorityClassStats
+{
+    int interruptCount;
+    long totalLatencyUSec;
+    long maxLatencyUSec;
+} PriorityClassStats;
+
+// an operation queued for submission, as sendProcessToInterrupt takes it
+typedef struct SubmitEntry
 {
-    InterruptManager *manager;
     PCBType *process;
     int processTime;
-} InterruptThreadArgs;
+    char *deviceName;
+    long submitTime;
+} SubmitEntry;
+
+// single producer ring, only the cpu thread queues entries and moves tail, 
+//    entries are taken and head moved under queueLock
+typedef struct SubmitRing
+{
+    SubmitEntry entries[ SUBMIT_RING_SLOTS ];
+    long head;
+    long tail;
+} SubmitRing;
+
+typedef struct TimingWheel
+{
+    // slot lists, each sorted by dueTime, then by sequence
+    struct InterruptNode *slots[ WHEEL_LEVELS ][ WHEEL_SLOTS ];
+
+    // next tick to expire, every node due before it has been released
+    long currentTick;
+
+    // no node in the wheel is due before this tick, 
+    //    lets the cpu skip queueLock while nothing can be released
+    long nextDueTick;
+
+    // stamps nodes in the order sent, breaks ties between equal dueTimes
+    long nextSequence;
+} TimingWheel;
+
+typedef struct InterruptManager
+{
+    // ready queue popped without a lock, producers holding queueLock 
+    //    swap in readyQueueTail, only the cpu thread moves readyQueueStart
+    // readyStub is requeued whenever the last node is taken, 
+    //    so the queue always holds at least one node
+    InterruptNode *readyQueueStart;
+    InterruptNode *readyQueueTail;
+    InterruptNode readyStub;
+    int readyCount;
+
+    TimingWheel pendingWheel;
+    TimerContextType *timer;
+    OutputFormatType *outputFormat;
+
+    // devices seen so far, with the channel counts and service order 
+    //    from the config
+    DeviceQueue *deviceList;
+    ConfigDataType *config;
+
+    // admitted operations, capped by maxInFlight unless it is 0, 
+    //    operations past the cap park in the submission queue
+    int maxInFlight;
+    int inFlight;
+    InterruptNode *submitStart;
+    InterruptNode *submitTail;
+    int submitDepth;
+
+    // operations that parked, the deepest the queue got, 
+    //    and the time spent waiting for admission
+    int parkedCount;
+    int maxSubmitDepth;
+    long totalAdmitWaitUSec;
+    long maxAdmitWaitUSec;
+
+    // completions ready within coalesceWindowUSec of the oldest, 
+    //    up to coalesceCount of them, are delivered as one interrupt, 
+    //    a window of 0 delivers them as soon as they are ready
+    long coalesceWindowUSec;
+    int coalesceCount;
+
+    // service latency of each priority class, only the cpu thread 
+    //    updates these
+    PriorityClassStats priorityStats[ INTERRUPT_PRIORITY_CLASSES ];
+
+    // operations queued by the cpu, not yet submitted
+    SubmitRing submitRing;
+
+    // nodes are taken from and returned to this pool
+    NodePool nodePool;
+    pthread_mutex_t queueLock;
+    int pendingOperations;
+
+    // signaled whenever a node reaches the ready queue, 
+    //    the idle cpu sleeps on it in real time mode
+    pthread_cond_t readyCond;
+
+    // real time mode I/O worker, not started in virtual time mode
+    pthread_t ioWorker;
+    bool workerStarted;
+    pthread_cond_t workerCond;
+    bool stopWorker;
+} InterruptManager;
+
+/*
+Name: admitOperation
+Process: admits a node at admitTime, counting it in flight, 
+         records how long it waited for admission, 
+         starts it at its device if a channel is free, 
+            otherwise queues it at the device
+note: requires queueLock to be held by the caller
+*/
+void admitOperation( InterruptManager *manager, InterruptNode *node, 
+                                                              long admitTime );
+
+/*
+Name: advanceWheel
+Process: expires every wheel tick up to the simulated time nowTicks, 
+         moving the nodes due in each tick onto the ready queue
+         and decrementing the count of pending operations for each, 
+         cascades higher levels down as the first level wraps
+note: requires queueLock to be held by the caller
+*/
+void advanceWheel( InterruptManager *manager, long nowTicks );
 
 /*
 Name: clearInterruptNode
-Process: clear memory for the node
+Process: returns the node to the manager's node pool
 */
-InterruptNode *clearInterruptNode( InterruptNode *node );
+InterruptNode *clearInterruptNode( InterruptManager *manager, 
+                                                        InterruptNode *node );
 
 /*
 Name: clearInterruptManager
-Process: waits for all threads to end, 
-         clears all nodes, 
+Process: waits for all pending operations to complete, 
+         clears all nodes, including the node pool, 
+         stops and joins the I/O worker, 
          clears memory for self
 note: this will wait until all interrupts have completed 
       their time before ending
 */
 InterruptManager *clearInterruptManager( InterruptManager *manager );
 
+/*
+Name: coalescedReadyTime
+Process: returns the simulated time the ready completions are due 
+            to the cpu, -1 if none are ready
+         without a coalescing window, or once coalesceCount are ready 
+            or nothing else is pending, that of the oldest one, 
+         otherwise the end of the oldest one's window
+note: only the cpu thread may call this
+*/
+long coalescedReadyTime( InterruptManager *manager );
+
+/*
+Name: collectInterrupts
+Process: drains newly completed nodes and merges them into batch, 
+            keeping it in service order, 
+         a higher priority completion goes ahead of lower ones 
+            already waiting in the batch
+note: only the cpu thread may call this
+*/
+void collectInterrupts( InterruptManager *manager, InterruptNode **batch );
+
+/*
+Name: completesBefore
+Process: returns if the first node completes before the second, 
+         by dueTime, then by the order the two were sent
+*/
+bool completesBefore( InterruptNode *first, InterruptNode *second );
+
+/*
+Name: completeOperation
+Process: moves a node whose service has ended onto the ready queue, 
+         decrements the count of pending operations, 
+         frees its device channel, starting the next queued request 
+            at the moment this one completed, 
+         frees its in-flight slot, admitting the next parked operation 
+            at the same moment
+note: requires queueLock to be held by the caller
+*/
+void completeOperation( InterruptManager *manager, InterruptNode *node );
+
 /*
 Name: createInterruptNode
-Process: allocate memory for data structure, 
+Process: takes a node from the manager's node pool, 
+            allocating one only if the pool is empty, 
          sets process as a reference to the pcbRef
 */
-InterruptNode *createInterruptNode( PCBType *pcbRef );
+InterruptNode *createInterruptNode( InterruptManager *manager, 
+                                                           PCBType *pcbRef );
 
 /*
 Name: create interrupt manager
 Process: allocates memory to the data structure, 
-         initializes as an empty queue, 
+         initializes as an empty queue and empty wheel, 
          initialize mutex, used to prevent race conditions
+         interrupts are timed with the simulation's timer, 
+         stats are logged to the simulation's output, 
+         devices are served as the config sets, 
+         in real time mode, starts the I/O worker
+*/
+InterruptManager *createInterruptManager( TimerContextType *timer, 
+                                          OutputFormatType *outputFormat, 
+                                                   ConfigDataType *configPtr );
+
+/*
+Name: displayAdmissionStats
+Process: outputs the in-flight cap, the operations that parked, 
+            the deepest the submission queue got and the admission wait, 
+         outputs nothing if there is no cap
+*/
+void displayAdmissionStats( InterruptManager *manager );
+
+/*
+Name: displayDeviceStats
+Process: outputs one line per device used, 
+         with its channels, requests, queue wait and latency, 
+         outputs nothing if no channels or service order are configured
+*/
+void displayDeviceStats( InterruptManager *manager );
+
+/*
+Name: displayNodePoolStats
+Process: outputs the node pool hits, misses and free nodes, 
+         outputs nothing unless diagnostic stats are on (-ds) 
+            or if no node was ever taken
+*/
+void displayNodePoolStats( InterruptManager *manager );
+
+/*
+Name: displayPriorityStats
+Process: outputs one line per priority class with serviced interrupts, 
+            with the count and the latency from completion to service, 
+         outputs nothing if every interrupt had the lowest priority
+*/
+void displayPriorityStats( InterruptManager *manager );
+
+/*
+Name: drainInterrupts
+Process: pops every completed node from the ready queue in one pass, 
+         returns them as a list in service order, by servicedBefore, 
+            NULL if none are ready
+         when coalescing, returns NULL until an interrupt is due, 
+            then only the nodes within the window of the oldest, 
+            at most coalesceCount of them
+         the caller takes them off the list with getBatchProcess
+note: only the cpu thread may call this
+*/
+InterruptNode *drainInterrupts( InterruptManager *manager );
+
+/*
+Name: enqueueReadyNode
+Process: links a node onto the tail of the lock-free ready queue, 
+         does not count or signal it, used for the stub as well
+*/
+void enqueueReadyNode( InterruptManager *manager, InterruptNode *toPush );
+
+/*
+Name: findNextDueTick
+Process: sets nextDueTick to the first tick from currentTick whose first 
+            level slot holds a node, 
+         stops at the next first level wrap, where a higher level may 
+            cascade nodes down
+note: requires queueLock to be held by the caller
+*/
+void findNextDueTick( TimingWheel *wheel );
+
+/*
+Name: flushSubmitRing
+Process: takes every queued entry from the submission ring, 
+         for each, brings the wheel up to its submit time, 
+            creates its node and admits or parks it, 
+            as sendProcessToInterrupt describes, 
+         returns the number of entries taken
+note: requires queueLock to be held by the caller
+*/
+int flushSubmitRing( InterruptManager *manager );
+
+/*
+Name: getDeviceQueue
+Process: returns the queue of the named device, 
+         creating it with the config's channel count and priority 
+            on first use
+note: requires queueLock to be held by the caller
+*/
+DeviceQueue *getDeviceQueue( InterruptManager *manager, char *deviceName );
+
+/*
+Name: getBatchProcess
+Process: removes the first node from a drained batch, 
+         records its latency in its priority class, 
+         returns the node to the manager's node pool, 
+         returns its process, NULL if the batch is empty
 */
-InterruptManager *createInterruptManager();
+PCBType *getBatchProcess( InterruptManager *manager, InterruptNode **batch );
 
 /*
 Name: getInterruptProcess
@@ -102,64 +483,169 @@ Process: pops an interrupt from the queue, if exists,
 */
 PCBType *getInterruptProcess( InterruptManager *manager );
 
+/*
+Name: idleUntilInterrupt
+Process: called while the cpu is idle, 
+         in virtual time mode, advances the simulated clock to the 
+            completion time of the next pending interrupt
+         in real time mode, sleeps on readyCond until a node reaches 
+            the ready queue or nothing is left pending
+         when coalescing, also waits until the interrupt is due
+*/
+void idleUntilInterrupt( InterruptManager *manager );
+
+/*
+Name: insertWheelNode
+Process: places a node in the wheel slot for its dueTime, 
+            the first level holds the next WHEEL_SLOTS ticks, 
+            each higher level holds a WHEEL_SLOTS times longer span
+         returns if the node was placed in the wheel, 
+            false if it is already due
+note: requires queueLock to be held by the caller
+*/
+bool insertWheelNode( InterruptManager *manager, InterruptNode *toInsert );
+
+/*
+Name: interruptDue
+Process: returns if the cpu should take an interrupt now, 
+            without a coalescing window, if any completion is ready, 
+            otherwise once coalescedReadyTime has passed
+note: only the cpu thread may call this, 
+      without holding queueLock in virtual time mode
+*/
+bool interruptDue( InterruptManager *manager );
+
+/*
+Name: ioWorkerThread
+Process: real time mode only, the I/O worker, 
+         sleeps until the wheel holds a node, 
+         then waits out the next tick and advances the wheel to the timer, 
+         ends when stopWorker is set
+*/
+void *ioWorkerThread( void *voidManager );
+
 /*
 Name: isEmpty
-Process: returns if there are completed processes stored in the manager
+Process: returns if there are completed processes stored in the manager, 
+         an atomic load of readyCount
 */
 bool isEmpty( InterruptManager *manager );
 
 /*
-Name: modify running threads
-Process: modify the number of running threads. 
-         this is the only function that modifies 
-            runningThreads after initialization
-         queueLock prevents runningThreads from being modified by 
-            multiple calls at the same time. 
+Name: peekInterrupt
+Process: returns the node popInterrupt would return next, 
+            NULL if the queue is empty, 
+         does not remove it
+note: only the cpu thread may call this
 */
-void modifyRunningThreads( InterruptManager *manager, int modifier );
+InterruptNode *peekInterrupt( InterruptManager *manager );
 
 /*
 Name: popInterrupt
 Process: selects the node at the start of the queue, 
          if it exists, moves the start to the next node, 
             and returns the popped node. 
-         if the queue is empty, returns NULL
-         uses queueLock to prevent other sources from modifying the 
-            queue at the same time
+         if the queue is empty, returns NULL, 
+            also NULL while the only node is still being linked by a push
+note: only the cpu thread may call this, without holding queueLock
 */
 InterruptNode *popInterrupt( InterruptManager *manager );
 
 /*
-Name: pushInterrupt
-Process: pushes a node onto the tail
-         updates tail, and start if necessary
-         uses queueLock to prevent other sources from modifying 
-            the queue at the same time
+Name: pushInterruptLocked
+Process: pushes a node onto the tail of the ready queue, 
+         counts it in readyCount, 
+         wakes the idle cpu
+note: requires queueLock to be held by the caller
+*/
+void pushInterruptLocked( InterruptManager *manager, InterruptNode *toPush );
+
+/*
+Name: queueDeviceRequest
+Process: adds a node to its device's wait queue, 
+            at the tail in FIFO order, 
+            before any longer request in SJF order
+note: requires queueLock to be held by the caller
 */
-void pushInterrupt( InterruptManager *manager, InterruptNode *toPush );
+void queueDeviceRequest( InterruptManager *manager, InterruptNode *node );
+
+/*
+Name: queueSubmission
+Process: queues an operation needing processTime at the named device 
+            in the submission ring, stamped with the current time, 
+            without taking a lock, 
+         returns false if the ring is full, 
+         the manager does not see it until submitOperations
+note: only the cpu thread may call this
+*/
+bool queueSubmission( InterruptManager *manager, PCBType *process, 
+                                       int processTime, char *deviceName );
+
+/*
+Name: reapCompletions
+Process: pops up to maxCount completed nodes from the ready queue, 
+            in the order popInterrupt returns them, 
+         stores their processes in processes, returns each node 
+            to the node pool, 
+         returns the number reaped
+note: only the cpu thread may call this
+*/
+int reapCompletions( InterruptManager *manager, PCBType **processes, 
+                                                              int maxCount );
+
+/*
+Name: releaseDueInterrupts
+Process: in virtual time mode, advances the wheel to the simulated clock, 
+            moving every completed node onto the ready queue, 
+         takes queueLock only if a node may be due
+         in real time mode the I/O worker does this, does nothing
+*/
+void releaseDueInterrupts( InterruptManager *manager );
 
 /*
 Name: sendProcessToInterrupt
-Process: create data structure to store thread arguments in, 
-         increment the number of threads running, 
-         create a thread to send the process to the interrupt manager
+Process: create a node needing processTime at the named device, 
+         admits it now if under the in-flight cap, 
+            otherwise parks it in the submission queue, 
+         increments the number of pending operations and wakes the worker, 
+         a one entry batch through queueSubmission and submitOperations
+note: only the cpu thread may call this
 */
 void sendProcessToInterrupt( InterruptManager *manager, PCBType *process, 
-                             int processTime );
+                             int processTime, char *deviceName );
+
+/*
+Name: servicedBefore
+Process: returns if the first node is serviced before the second, 
+         by the priority of its device, then by completesBefore
+*/
+bool servicedBefore( InterruptNode *first, InterruptNode *second );
+
+/*
+Name: startDeviceService
+Process: takes a channel of the node's device at startTime, 
+         records how long the request waited, 
+         stores the node in the wheel, due once its service time passes, 
+         completes it at once if already due
+note: requires queueLock to be held by the caller
+*/
+void startDeviceService( InterruptManager *manager, InterruptNode *node, 
+                                                              long startTime );
 
 /*
-Name: sendProcessToInterruptThread
-Process: store the process in an interruptNode, 
-         wait for the specified time, 
-         stores the node in the manager. 
-         After, decrement the count of running threads
+Name: submitOperations
+Process: submits every operation queued in the submission ring, 
+            taking queueLock once for the whole batch, 
+         wakes the worker if any were submitted, 
+         returns the number submitted
 */
-void *sendProcessToInterruptThread( void *voidArgs );
+int submitOperations( InterruptManager *manager );
 
 /*
 Name: waitingForProcesses
-Process: returns if threads are being ran
+Process: returns if operations are still pending, 
+         an atomic load of pendingOperations
 */
 bool waitingForProcesses( InterruptManager *manager );
 
-#endif // INTERRUPT_OPS_H
\ No newline at end of file
+#endif // INTERRUPT_OPS_H
@@ -129,11 +129,13 @@ MemorySegmentType *createMemory( int capacity )
 /*
 Name: deallocateMemoryFromProcess
 Process: deallocated memory from every segment in memory 
-           dedicated to the provided pid
+           dedicated to the provided pid, 
+         then displays the memory to format
 Return: NULL ptr
 */
 MemorySegmentType *deallocateMemoryFromProcess( MemorySegmentType **memoryHead, 
-                                                                       int pid )
+                                                int pid, 
+                                                OutputFormatType *format )
 {
     MemorySegmentType *wkgSegment;
     char outStr[ MAX_STR_LEN ];
@@ -149,7 +151,7 @@ MemorySegmentType *deallocateMemoryFromProcess( MemorySegmentType **memoryHead,
     }
 
     sprintf( outStr, "After clear process %i success\n", pid );
-    displayMemory( *memoryHead, outStr );
+    displayMemory( *memoryHead, outStr, format );
     return NULL;
 }
 
@@ -222,9 +224,11 @@ MemorySegmentType *deallocateMemoryFromSegment(
 /*
 Name: displayMemory
 Process: displays every segment in the memory list, 
-         or "No memory configured" if none
+         or "No memory configured" if none, 
+         to the simulation's output format
 */
-void displayMemory( MemorySegmentType *memoryHead, char *label )
+void displayMemory( MemorySegmentType *memoryHead, char *label, 
+                                                     OutputFormatType *format )
 {
     char outputString[ HUGE_STR_LEN ];
     char inUseStr[ MIN_STR_LEN ];
@@ -232,13 +236,14 @@ void displayMemory( MemorySegmentType *memoryHead, char *label )
     int logicalStart, logicalEnd, physicalStart, physicalEnd;
 
     MemorySegmentType *wkgSeg;
-    outputDirectly( "--------------------------------------------------\n" );
-    outputDirectly( label );
+    outputDirectly( format, 
+                    "--------------------------------------------------\n" );
+    outputDirectly( format, label );
 
     // check for no memory 
     if( memoryHead == NULL )
     {
-        outputDirectly( "No memory configured\n" );
+        outputDirectly( format, "No memory configured\n" );
     }
 
     // display all values
@@ -269,9 +274,10 @@ void displayMemory( MemorySegmentType *memoryHead, char *label )
                       physicalStart, inUseStr, pidStr, 
                       logicalStart, logicalEnd, 
                       physicalEnd );
-        outputDirectly( outputString );
+        outputDirectly( format, outputString );
     }
-    outputDirectly( "--------------------------------------------------\n" );
+    outputDirectly( format, 
+                    "--------------------------------------------------\n" );
 }
 
 /*
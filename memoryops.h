@@ -46,11 +46,13 @@ MemorySegmentType *createMemory( int capacity );
 /*
 Name: deallocateMemoryFromProcess
 Process: deallocated memory from every segment in memory 
-           dedicated to the provided pid
+           dedicated to the provided pid, 
+         then displays the memory to format
 Return: NULL ptr
 */
 MemorySegmentType *deallocateMemoryFromProcess( MemorySegmentType **memoryHead, 
-                                                                       int pid );
+                                                int pid, 
+                                                OutputFormatType *format );
 
 
 /*
@@ -67,9 +69,11 @@ MemorySegmentType *deallocateMemoryFromSegment(
 /*
 Name: displayMemory
 Process: displays every segment in the memory list, 
-         or "No memory configured" if none
+         or "No memory configured" if none, 
+         to the simulation's output format
 */
-void displayMemory( MemorySegmentType *memoryHead, char *label );
+void displayMemory( MemorySegmentType *memoryHead, char *label, 
+                                                     OutputFormatType *format );
 
 /*
 Name: memoryAccess
@@ -34,6 +34,7 @@ OpCodeType *addNode( OpCodeType *localPtr, OpCodeType *newNode )
         copyString( localPtr->strArg1, newNode->strArg1 );
         localPtr->intArg2 = newNode->intArg2;
         localPtr->intArg3 = newNode->intArg3;
+        localPtr->intArg4 = newNode->intArg4;
         localPtr->opEndTime = newNode->opEndTime;
 
         localPtr->nextNode = NULL;
@@ -431,7 +432,8 @@ Function Output/Returned: coded result of operation (OpCodeMessages)
 Device Input/Device: op code line uploaded
 Device Output/Device: none
 Dependencies: getStringToDelimiter, getCommand, copyString, verifyValidCommand, 
-              compareString, getStringArg, verifyFirstStringArg, getNumberArg
+              compareString, getStringArg, verifyFirstStringArg, getNumberArg, 
+              hasNextArg
 */
 OpCodeMessages getOpCommand( FILE *filePtr, OpCodeType *inData )
 {
@@ -449,6 +451,7 @@ OpCodeMessages getOpCommand( FILE *filePtr, OpCodeType *inData )
         int runningStringIndex = 0;
         bool arg2FailureFlag = false;
         bool arg3FailureFlag = false;
+        bool arg4FailureFlag = false;
 
     // get whole op command as string, check for successful access
         // function: getStringToDelimiter
@@ -486,6 +489,7 @@ OpCodeMessages getOpCommand( FILE *filePtr, OpCodeType *inData )
     inData->inOutArg[ 0 ] = NULL_CHAR;
     inData->intArg2 = 0;
     inData->intArg3 = 0;
+    inData->intArg4 = 0;
     inData->opEndTime = 0.0;
     inData->nextNode = NULL;
 
@@ -549,6 +553,46 @@ OpCodeMessages getOpCommand( FILE *filePtr, OpCodeType *inData )
 
         // set first int argument to nubmer
         inData->intArg2 = numBuffer;
+
+        // check for optional cpu share argument
+            // function: hasNextArg
+        if( hasNextArg( strBuffer, runningStringIndex ) )
+        {
+            // get number argument
+                // function: getNumberArg
+            runningStringIndex = getNumberArg( &numBuffer, 
+                                               strBuffer, runningStringIndex );
+
+            // check for failed number access
+            if( numBuffer <= BAD_ARG_VAL )
+            {
+                // set failure flag
+                arg3FailureFlag = true;
+            }
+
+            // set second int argument to share, 0 uses the default
+            inData->intArg3 = numBuffer;
+        }
+
+        // check for optional relative deadline argument, after the share
+            // function: hasNextArg
+        if( hasNextArg( strBuffer, runningStringIndex ) )
+        {
+            // get number argument
+                // function: getNumberArg
+            runningStringIndex = getNumberArg( &numBuffer, 
+                                               strBuffer, runningStringIndex );
+
+            // check for failed number access
+            if( numBuffer <= BAD_ARG_VAL )
+            {
+                // set failure flag
+                arg4FailureFlag = true;
+            }
+
+            // set third int argument to deadline msec, 0 is none
+            inData->intArg4 = numBuffer;
+        }
     }
 
     // check for cpu cycle time
@@ -623,7 +667,7 @@ OpCodeMessages getOpCommand( FILE *filePtr, OpCodeType *inData )
     }
 
     // check int args for uploaded failure
-    if( arg2FailureFlag || arg3FailureFlag )
+    if( arg2FailureFlag || arg3FailureFlag || arg4FailureFlag )
     {
         // return corrupt op command error error
         return CORRUPT_OPCMD_ERR;
@@ -720,6 +764,30 @@ int getStringArg( char *strArg, const char *inputStr, int index )
 }
 
 
+/*
+Name: hasNextArg
+Process: starts at given index, skips white space, and tests for a comma 
+         starting another argument
+Function Input/Parameters: input string (const char *), starting index (int)
+Function Output/Parameters: none
+Function Output/Returned: Boolean result of test (bool)
+Device Input/Device: none
+Device Output/Device: none
+Dependencies: none
+*/
+bool hasNextArg( const char *inputStr, int index )
+{
+    // loop to skip white space, stopping at the end of the string
+    while( inputStr[ index ] != NULL_CHAR && inputStr[ index ] <= SPACE )
+    {
+        index++;
+    }
+
+    // return if an argument follows
+    return inputStr[ index ] == COMMA;
+}
+
+
 /*
 Name: isDigit
 Process: tests character parameter for digit, returns true if is digit, 
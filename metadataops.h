@@ -121,7 +121,8 @@ Function Output/Returned: coded result of operation (OpCodeMessages)
 Device Input/Device: op code line uploaded
 Device Output/Device: none
 Dependencies: getStringToDelimiter, getCommand, copyString, verifyValidCommand, 
-              compareString, getStringArg, verifyFirstStringArg, getNumberArg
+              compareString, getStringArg, verifyFirstStringArg, getNumberArg, 
+              hasNextArg
 */
 OpCodeMessages getOpCommand( FILE *filePtr, OpCodeType *inData );
 
@@ -157,6 +158,20 @@ Dependencies: none
 int getStringArg( char *strArg, const char *inputStr, int index );
 
 
+/*
+Name: hasNextArg
+Process: starts at given index, skips white space, and tests for a comma 
+         starting another argument
+Function Input/Parameters: input string (const char *), starting index (int)
+Function Output/Parameters: none
+Function Output/Returned: Boolean result of test (bool)
+Device Input/Device: none
+Device Output/Device: none
+Dependencies: none
+*/
+bool hasNextArg( const char *inputStr, int index );
+
+
 /*
 Name: isDigit
 Process: tests character parameter for digit, returns true if is digit, 
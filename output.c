@@ -1,81 +1,96 @@
 #include "output.h"
 
 
-void output( char *toDisplay )
+void output( OutputFormatType *format, TimerContextType *timer, 
+                                                           char *toDisplay )
 {
-    char timeStr[ MIN_STR_LEN ];
-    char outstr[ MAX_STR_LEN ];
-    accessTimer( LAP_TIMER, timeStr );
-    sprintf( outstr, "%10s, %s", timeStr, toDisplay );
-    outputDirectly( outstr );
-}
+    OutputRecordType record;
+    char outStr[ HUGE_STR_LEN ];
+
+    // take the raw time only, formatting is left to whoever displays it
+    record.ticks = getTimerTicks( timer );
 
-void outputDirectly( char *outStr )
-{
-    OutputFormatType *format;
-    format = accessOutputFormat();
     if( format->consoleDisplay )
     {
+        copyString( record.text, toDisplay );
+        formatOutputRecord( outStr, &record );
         printf( "%s", outStr );
     }
     if( format->fileDisplay )
     {
-        addStringToOutput( accessOutputFormat(), outStr );
+        addRecordToOutput( format, record.ticks, toDisplay );
     }
 }
 
-void outputNewline()
+void outputDirectly( OutputFormatType *format, char *outStr )
 {
-    outputDirectly( "\n" );
+    if( format->consoleDisplay )
+    {
+        printf( "%s", outStr );
+    }
+    if( format->fileDisplay )
+    {
+        addRecordToOutput( format, NO_TIMESTAMP, outStr );
+    }
 }
 
-OutputFormatType *accessOutputFormat()
+void outputNewline( OutputFormatType *format )
 {
-    static OutputFormatType outputData;
-
-    return &outputData;
+    outputDirectly( format, "\n" );
 }
 
-
-void setFileOutput( bool isSet )
+OutputFormatType *createOutputFormat( bool consoleDisplay, bool fileDisplay )
 {
-    OutputFormatType *format;
-    format = accessOutputFormat();
+    OutputFormatType *format 
+                   = (OutputFormatType *)malloc( sizeof( OutputFormatType ) );
+
+    format->consoleDisplay = consoleDisplay;
+    format->fileDisplay = fileDisplay;
+    format->records = NULL;
+    format->size = 0;
+    format->capacity = 0;
 
-    format->fileDisplay = isSet;
-    if( isSet )
+    if( fileDisplay )
     {
         // initialize the output array
         initializeOutputArr( format );
     }
+
+    return format;
 }
 
-void setConsoleOutput( bool isSet )
+OutputFormatType *clearOutputFormat( OutputFormatType *format )
 {
-    OutputFormatType *format;
-    format = accessOutputFormat();
-    format->consoleDisplay = isSet;
+    // records are freed already if they were written to file
+    if( format->fileDisplay )
+    {
+        free( format->records );
+    }
+    free( format );
+
+    return NULL;
 }
 
-void displayDataToFile( const char *filename )
+void displayDataToFile( OutputFormatType *format, const char *filename )
 {
-    OutputFormatType *format = accessOutputFormat();
     FILE *filePtr;
-    int strInd;
+    int recordInd;
+    char outStr[ HUGE_STR_LEN ];
 
     if( format->fileDisplay )
     {
         filePtr = fopen( filename, "w" );
 
-        // print all strings in stringArr to file
-        for( strInd = 0; strInd < format->size; strInd++ )
+        // format and print all records to file
+        for( recordInd = 0; recordInd < format->size; recordInd++ )
         {
-            fprintf( filePtr, "%s", format->stringArr[ strInd ] );
+            formatOutputRecord( outStr, &format->records[ recordInd ] );
+            fprintf( filePtr, "%s", outStr );
         }
 
         // destruct all memory
         fclose( filePtr );
-        freeStringArray( format->stringArr, format->capacity );
+        free( format->records );
 
         // set unable to display
         format->fileDisplay = false;
@@ -87,81 +102,46 @@ void initializeOutputArr( OutputFormatType *format )
 {
     format->size = 0;
 
-    // allocate memory for one string
+    // allocate memory for one record
     format->capacity = 1;
-    format->stringArr = (char **)malloc( sizeof( char * ) * format->capacity );
-    format->stringArr[0] = (char *)malloc( sizeof( char *) * MAX_STR_LEN );
+    format->records = (OutputRecordType *)malloc( 
+                            sizeof( OutputRecordType ) * format->capacity );
 }
 
-void addStringToOutput( OutputFormatType *format, const char *newString )
+void addRecordToOutput( OutputFormatType *format, long ticks, 
+                                                        const char *newString )
 {
-    char **newStringArr;
-    int wkgStringIndex;
-    int newCapacity;
-
-    // realllocate memory if not enough capacity
+    // reallocate memory if not enough capacity
     if( format->size >= format->capacity )
     {
-        // double capacity
-        newCapacity = format->capacity * 2;
-        // allocate memory for newStringArr
-        newStringArr = (char **)malloc( sizeof(char *) * newCapacity );
-
-        // allocate memory through capacity
-        for( wkgStringIndex = 0; 
-                     wkgStringIndex < newCapacity; 
-                             wkgStringIndex++ )
-        {
-            // allocate memory for new string
-            newStringArr[ wkgStringIndex ] = (char *)malloc( 
-                                                sizeof( char *) * MAX_STR_LEN );
-        }
-
-        // copy current data from format into newStringArr
-        for( wkgStringIndex = 0; 
-                     wkgStringIndex < format->size; 
-                             wkgStringIndex++ )
-        {
-            // copy old string into new string
-            copyString( newStringArr[ wkgStringIndex ], 
-                                          format->stringArr[ wkgStringIndex ] );
-        }
-
-        // free old memory
-        freeStringArray( format->stringArr, format->capacity );
-
-        // set new values
-        format->capacity = newCapacity;
-        format->stringArr = newStringArr;
+        // double capacity, records are copied by realloc
+        format->capacity = format->capacity * 2;
+        format->records = (OutputRecordType *)realloc( format->records, 
+                            sizeof( OutputRecordType ) * format->capacity );
     }
     // done reallocating, assume sufficient memory
 
-    // copy the newString at the end
-    copyString( format->stringArr[ format->size ], newString );
+    // store the new record at the end
+    format->records[ format->size ].ticks = ticks;
+    copyString( format->records[ format->size ].text, newString );
 
     // increment the size
     format->size++;
 }
 
-void freeStringArray( char **stringArr, int capacity )
+void formatOutputRecord( char *outStr, OutputRecordType *record )
 {
-    int wkgStringIndex;
+    char timeStr[ MIN_STR_LEN ];
 
-    // first free string memory
-    for( wkgStringIndex = 0; 
-                wkgStringIndex < capacity; 
-                          wkgStringIndex++ )
+    // untimed records are displayed as is
+    if( record->ticks == NO_TIMESTAMP )
     {
-        free( stringArr[ wkgStringIndex ] );
+        copyString( outStr, record->text );
+    }
+    else
+    {
+        timeToString( record->ticks / 1000000, record->ticks % 1000000, 
+                                                                     timeStr );
+        snprintf( outStr, HUGE_STR_LEN, "%10s, %s", timeStr, record->text );
     }
-
-    // free string array
-   free( stringArr );
 }
-
-
-
-
-
-
-
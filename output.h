@@ -7,35 +7,50 @@
 #include <stdio.h>
 #include <stdlib.h>
 
+// timestamp of a record displayed without a time
+#define NO_TIMESTAMP -1
+
+/*
+one buffered line of file output
+the timestamp is kept as raw simulated microseconds and 
+   only formatted when the line is written to the file
+*/
+typedef struct OutputRecordStruct
+{
+    long ticks;
+    char text[ MAX_STR_LEN ];
+} OutputRecordType;
 
+// output state owned by one simulation, like its timer context
 typedef struct OutputFormatStruct
 {
     bool fileDisplay, consoleDisplay;
-    char **stringArr;
+    OutputRecordType *records;
     int size, capacity;
 } OutputFormatType;
 
 
 
 
-void output( char *toDisplay );
-
-void outputDirectly( char *toDisplay );
+void output( OutputFormatType *format, TimerContextType *timer, 
+                                                           char *toDisplay );
 
-void outputNewline();
+void outputDirectly( OutputFormatType *format, char *toDisplay );
 
-OutputFormatType *accessOutputFormat();
+void outputNewline( OutputFormatType *format );
 
-void setFileOutput( bool isSet );
+OutputFormatType *createOutputFormat( bool consoleDisplay, bool fileDisplay );
 
-void setConsoleOutput( bool isSet );
+OutputFormatType *clearOutputFormat( OutputFormatType *format );
 
-void displayDataToFile( const char *filename );
+void displayDataToFile( OutputFormatType *format, const char *filename );
 
 void initializeOutputArr( OutputFormatType *format );
 
-void addStringToOutput( OutputFormatType *format, const char *newString );
+void addRecordToOutput( OutputFormatType *format, long ticks, 
+                                                        const char *newString );
 
-void freeStringArray( char **stringArr, int capacity );
+// outStr requires HUGE_STR_LEN characters
+void formatOutputRecord( char *outStr, OutputRecordType *record );
 
 #endif // OUTPUT_H
@@ -12,6 +12,96 @@ void appendNodeToManager( PCBManagerType *manager, PCBType *toAppend )
 
 }
 
+/*
+Name: changePCBState
+Process: set's pcbObj's state to newState, 
+         moves it to the state list for newState, 
+         tells the scheduler if it became or stopped being runnable, 
+            unless notifyScheduler is false, 
+         records its arrival and adds its turnaround when it exits, 
+         displays the change in state
+*/
+void changePCBState( TimerContextType *timer, PCBType *pcbObj, 
+                             ProcessState newState, bool notifyScheduler )
+{
+    char outputString[ HUGE_STR_LEN ];
+    ProcessState oldState;
+    if( pcbObj != NULL )
+    {
+        oldState = pcbObj->state;
+        sprintf( outputString, "OS: Process %i set from %s to %s\n", 
+                                  pcbObj->pid, getStateName( pcbObj->state ), 
+                                                  getStateName( newState ) );
+        if( pcbObj->manager != NULL )
+        {
+            unlinkStateList( pcbObj );
+        }
+        pcbObj->state = newState;
+        if( pcbObj->manager != NULL )
+        {
+            linkStateList( pcbObj );
+        }
+
+        // time turnaround from first becoming ready to exiting, 
+        //    a deadline falls due relative to the same arrival
+        if( oldState == NEW_STATE )
+        {
+            pcbObj->arrivalTime = getTimerTicks( timer );
+            pcbObj->deadlineTime = pcbObj->arrivalTime 
+                                 + (long)pcbObj->relativeDeadline * 1000;
+        }
+        if( newState == EXIT_STATE && pcbObj->manager != NULL )
+        {
+            pcbObj->manager->totalTurnaroundUSec += 
+                                getTimerTicks( timer ) - pcbObj->arrivalTime;
+        }
+        if( notifyScheduler )
+        {
+            updateSchedulerQueue( pcbObj, oldState );
+        }
+        output( pcbObj->manager->outputFormat, timer, outputString );
+
+        if( newState == EXIT_STATE )
+        {
+            checkProcessDeadline( timer, pcbObj );
+        }
+    }
+}
+
+/*
+Name: checkProcessDeadline
+Process: counts an exiting process that has a deadline, 
+         logs and sums its lateness if it finished after the deadline
+*/
+void checkProcessDeadline( TimerContextType *timer, PCBType *pcb )
+{
+    char outputString[ HUGE_STR_LEN ];
+    PCBManagerType *manager = pcb->manager;
+    long latenessUSec = getTimerTicks( timer ) - pcb->deadlineTime;
+
+    if( pcb->relativeDeadline == 0 || manager == NULL )
+    {
+        return;
+    }
+
+    manager->deadlineCount++;
+
+    if( latenessUSec > 0 )
+    {
+        manager->deadlineMissCount++;
+        manager->totalLatenessUSec += latenessUSec;
+        if( latenessUSec > manager->maxLatenessUSec )
+        {
+            manager->maxLatenessUSec = latenessUSec;
+        }
+
+        sprintf( outputString, 
+                 "OS: Process %i missed its deadline by %.3f ms\n", 
+                 pcb->pid, (double)latenessUSec / 1000.0 );
+        output( manager->outputFormat, timer, outputString );
+    }
+}
+
 /*
 Name: clearPCBList
 Process: removes all nodes from a list, starting at listNode
@@ -67,6 +157,18 @@ PCBType *clearPCBNode( PCBType *pcbObj )
     return NULL;
 }
 
+/*
+Name: clearReadyHeap
+Process: frees the heap's node array, leaving it empty
+*/
+void clearReadyHeap( ReadyHeapType *heap )
+{
+    free( heap->nodes );
+    heap->nodes = NULL;
+    heap->count = 0;
+    heap->capacity = 0;
+}
+
 /*
 Name: createPCBList
 Process: returns NULL, representing an empty list
@@ -79,16 +181,21 @@ PCBType *createPCBList()
 /*
 Name: createPCBManager
 Process: creates a PCBManagerType containing all of the 
-         data in the opCodePtr list
+         data in the opCodePtr list, 
+         timer and outputFormat are the simulation's, 
+            used to log state changes
 */
 PCBManagerType *createPCBManager( OpCodeType *opCodePtr, 
-                                  ConfigDataType *configPtr )
+                                  ConfigDataType *configPtr, 
+                                  TimerContextType *timer, 
+                                  OutputFormatType *outputFormat )
 {
     PCBManagerType *manager = (PCBManagerType *)malloc(sizeof(PCBManagerType));
 
     // create a opCodePtr to iterate over the list
     OpCodeType *wkgOpCodePtr = opCodePtr;
     PCBType *newNode;
+    int stateIndex;
 
     // skip start code
     wkgOpCodePtr = wkgOpCodePtr->nextNode;
@@ -96,6 +203,25 @@ PCBManagerType *createPCBManager( OpCodeType *opCodePtr,
     // create PCB list
     manager->pcbHead = createPCBList();
 
+    // the scheduler is chosen once the processes are known
+    manager->scheduler = NULL;
+    manager->currentPcb = NULL;
+    manager->unusedPid = 0;
+    manager->timer = timer;
+    manager->outputFormat = outputFormat;
+    manager->totalTurnaroundUSec = 0;
+    manager->deadlineCount = 0;
+    manager->deadlineMissCount = 0;
+    manager->totalLatenessUSec = 0;
+    manager->maxLatenessUSec = 0;
+
+    // every state list starts empty
+    for( stateIndex = 0; stateIndex < PROCESS_STATE_COUNT; stateIndex++ )
+    {
+        manager->stateHeads[ stateIndex ] = NULL;
+        manager->stateCounts[ stateIndex ] = 0;
+    }
+
     // iterate until sys end
         // not ( sys and end )
     while( !( compareString( wkgOpCodePtr->command, "sys" ) == 0 && 
@@ -110,6 +236,10 @@ PCBManagerType *createPCBManager( OpCodeType *opCodePtr,
 
         // add newNode into the pcb list
         appendNodeToManager( manager, newNode );
+
+        // it starts in the manager's new list
+        newNode->manager = manager;
+        linkStateList( newNode );
     }
 
     // skip sys end
@@ -132,8 +262,15 @@ PCBType *createPCBNode( OpCodeType **wkgOpCodePtr, ConfigDataType *configPtr )
 {
     // initialize variables
     PCBType *pcbResult = (PCBType *)malloc( sizeof( PCBType ) );
+    int shareTickets = DEFAULT_APP_SHARE;
+    int relativeDeadline = (*wkgOpCodePtr)->intArg4;
+
+    // assume start at "app start", it may give the app's cpu share
+    if( (*wkgOpCodePtr)->intArg3 > 0 )
+    {
+        shareTickets = (*wkgOpCodePtr)->intArg3;
+    }
 
-    // assume start at "app start"
     // advance past app start
     *wkgOpCodePtr = (*wkgOpCodePtr)->nextNode;
 
@@ -159,11 +296,270 @@ PCBType *createPCBNode( OpCodeType **wkgOpCodePtr, ConfigDataType *configPtr )
     pcbResult->remainingTotalTime = getPCBTime( pcbResult, configPtr );
     pcbResult->next = pcbResult;
     pcbResult->prev = pcbResult;
-    copyString( pcbResult->state, "NEW" );
+    pcbResult->statePrev = pcbResult;
+    pcbResult->stateNext = pcbResult;
+    pcbResult->queuePrev = pcbResult;
+    pcbResult->queueNext = pcbResult;
+    pcbResult->queueLevel = 0;
+    pcbResult->queueCycles = 0;
+    pcbResult->manager = NULL;
+    pcbResult->heapIndex = -1;
+    pcbResult->vruntime = 0;
+    pcbResult->treeParent = NULL;
+    pcbResult->treeLeft = NULL;
+    pcbResult->treeRight = NULL;
+    pcbResult->treeRed = false;
+    pcbResult->shareTickets = shareTickets;
+    pcbResult->passValue = 0;
+    pcbResult->relativeDeadline = relativeDeadline;
+    pcbResult->deadlineTime = 0;
+    pcbResult->state = NEW_STATE;
+    pcbResult->arrivalTime = 0;
 
     return pcbResult;
 }
 
+/*
+Name: deadlineBefore
+Process: returns if the first process is ahead of the second in a 
+            deadline heap, by deadline, then by pid, 
+         processes without a deadline follow those with one, 
+         orders the heap only, the pid tie break is not a preemption
+*/
+bool deadlineBefore( PCBType *first, PCBType *second )
+{
+    if( ( first->relativeDeadline == 0 ) != ( second->relativeDeadline == 0 ) )
+    {
+        return first->relativeDeadline != 0;
+    }
+
+    if( first->relativeDeadline != 0 
+     && first->deadlineTime != second->deadlineTime )
+    {
+        return first->deadlineTime < second->deadlineTime;
+    }
+
+    return first->pid < second->pid;
+}
+
+/*
+Name: displayDeadlineStats
+Process: displays how many exited processes missed their deadlines, 
+            and by how much, if any process had a deadline
+*/
+void displayDeadlineStats( PCBManagerType *manager )
+{
+    char outputString[ HUGE_STR_LEN ];
+
+    if( manager->deadlineCount == 0 )
+    {
+        return;
+    }
+
+    sprintf( outputString, 
+             "Deadlines: %d of %d missed (%.1f%%), "
+             "average lateness %.3f ms, worst %.3f ms\n", 
+             manager->deadlineMissCount, manager->deadlineCount, 
+             100.0 * manager->deadlineMissCount / manager->deadlineCount, 
+             manager->deadlineMissCount > 0 ? 
+                         (double)manager->totalLatenessUSec 
+                             / manager->deadlineMissCount / 1000.0 : 0.0, 
+             (double)manager->maxLatenessUSec / 1000.0 );
+    outputDirectly( manager->outputFormat, outputString );
+}
+
+/*
+Name: firstRunTree
+Process: returns the process with the least virtual runtime, 
+            the lowest pid among equal runtimes, 
+         NULL if the tree is empty
+*/
+PCBType *firstRunTree( RunTreeType *tree )
+{
+    PCBType *wkgPCB = tree->root;
+
+    if( wkgPCB == NULL )
+    {
+        return NULL;
+    }
+
+    while( wkgPCB->treeLeft != NULL )
+    {
+        wkgPCB = wkgPCB->treeLeft;
+    }
+
+    return wkgPCB;
+}
+
+/*
+Name: fixRunTreeInsert
+Process: restores the red-black rules after the red node was inserted
+*/
+void fixRunTreeInsert( RunTreeType *tree, PCBType *node )
+{
+    PCBType *parent, *grandparent, *uncle;
+
+    while( isRunTreeRed( node->treeParent ) )
+    {
+        parent = node->treeParent;
+        grandparent = parent->treeParent;
+
+        if( parent == grandparent->treeLeft )
+        {
+            uncle = grandparent->treeRight;
+
+            // red uncle, push the red up to the grandparent
+            if( isRunTreeRed( uncle ) )
+            {
+                parent->treeRed = false;
+                uncle->treeRed = false;
+                grandparent->treeRed = true;
+                node = grandparent;
+            }
+            else
+            {
+                // inner child, rotate it to the outside first
+                if( node == parent->treeRight )
+                {
+                    node = parent;
+                    rotateRunTreeLeft( tree, node );
+                    parent = node->treeParent;
+                }
+
+                parent->treeRed = false;
+                grandparent->treeRed = true;
+                rotateRunTreeRight( tree, grandparent );
+            }
+        }
+        else
+        {
+            uncle = grandparent->treeLeft;
+
+            // red uncle, push the red up to the grandparent
+            if( isRunTreeRed( uncle ) )
+            {
+                parent->treeRed = false;
+                uncle->treeRed = false;
+                grandparent->treeRed = true;
+                node = grandparent;
+            }
+            else
+            {
+                // inner child, rotate it to the outside first
+                if( node == parent->treeLeft )
+                {
+                    node = parent;
+                    rotateRunTreeRight( tree, node );
+                    parent = node->treeParent;
+                }
+
+                parent->treeRed = false;
+                grandparent->treeRed = true;
+                rotateRunTreeLeft( tree, grandparent );
+            }
+        }
+    }
+
+    tree->root->treeRed = false;
+}
+
+/*
+Name: fixRunTreeRemove
+Process: restores the red-black rules after a black node was removed, 
+            node took its place (it may be NULL) under parent
+*/
+void fixRunTreeRemove( RunTreeType *tree, PCBType *node, PCBType *parent )
+{
+    PCBType *sibling;
+
+    while( node != tree->root && !isRunTreeRed( node ) )
+    {
+        if( node == parent->treeLeft )
+        {
+            sibling = parent->treeRight;
+
+            // red sibling, rotate so the sibling is black
+            if( isRunTreeRed( sibling ) )
+            {
+                sibling->treeRed = false;
+                parent->treeRed = true;
+                rotateRunTreeLeft( tree, parent );
+                sibling = parent->treeRight;
+            }
+
+            // black nephews, move the missing black up a level
+            if( !isRunTreeRed( sibling->treeLeft ) 
+             && !isRunTreeRed( sibling->treeRight ) )
+            {
+                sibling->treeRed = true;
+                node = parent;
+                parent = node->treeParent;
+            }
+            else
+            {
+                // outer nephew black, rotate the red one outside
+                if( !isRunTreeRed( sibling->treeRight ) )
+                {
+                    sibling->treeLeft->treeRed = false;
+                    sibling->treeRed = true;
+                    rotateRunTreeRight( tree, sibling );
+                    sibling = parent->treeRight;
+                }
+
+                sibling->treeRed = parent->treeRed;
+                parent->treeRed = false;
+                sibling->treeRight->treeRed = false;
+                rotateRunTreeLeft( tree, parent );
+                node = tree->root;
+            }
+        }
+        else
+        {
+            sibling = parent->treeLeft;
+
+            // red sibling, rotate so the sibling is black
+            if( isRunTreeRed( sibling ) )
+            {
+                sibling->treeRed = false;
+                parent->treeRed = true;
+                rotateRunTreeRight( tree, parent );
+                sibling = parent->treeLeft;
+            }
+
+            // black nephews, move the missing black up a level
+            if( !isRunTreeRed( sibling->treeLeft ) 
+             && !isRunTreeRed( sibling->treeRight ) )
+            {
+                sibling->treeRed = true;
+                node = parent;
+                parent = node->treeParent;
+            }
+            else
+            {
+                // outer nephew black, rotate the red one outside
+                if( !isRunTreeRed( sibling->treeLeft ) )
+                {
+                    sibling->treeRight->treeRed = false;
+                    sibling->treeRed = true;
+                    rotateRunTreeLeft( tree, sibling );
+                    sibling = parent->treeLeft;
+                }
+
+                sibling->treeRed = parent->treeRed;
+                parent->treeRed = false;
+                sibling->treeLeft->treeRed = false;
+                rotateRunTreeRight( tree, parent );
+                node = tree->root;
+            }
+        }
+    }
+
+    if( node != NULL )
+    {
+        node->treeRed = false;
+    }
+}
+
 /*
 Name: getCycleRate
 Process: calculates the time per cycle for a program
@@ -202,6 +598,234 @@ int getPCBTime( PCBType *pcb, ConfigDataType *configPtr )
     return sum;
 }
 
+/*
+Name: getStateName
+Process: returns the display name of a process state, 
+         only needed when the state is logged
+*/
+const char *getStateName( ProcessState state )
+{
+    switch( state )
+    {
+        case NEW_STATE:
+            return "NEW";
+
+        case READY_STATE:
+            return "READY";
+
+        case RUNNING_STATE:
+            return "RUNNING";
+
+        case BLOCKED_STATE:
+            return "BLOCKED";
+
+        case EXIT_STATE:
+            return "EXIT";
+
+        default:
+            return "UNKNOWN";
+    }
+}
+
+/*
+Name: getStateProcessAfter
+Process: returns the first process in the manager's list for state 
+            with a pid above afterPid, 
+         NULL if there is none, 
+         walks the list from its head, O(n) in the processes passed
+*/
+PCBType *getStateProcessAfter( PCBManagerType *manager, ProcessState state, 
+                                                                int afterPid )
+{
+    PCBType *head = manager->stateHeads[ state ];
+    PCBType *wkgPCB = head;
+
+    if( head == NULL )
+    {
+        return NULL;
+    }
+
+    // the list is in pid order, stop at the first pid past afterPid
+    while( wkgPCB->pid <= afterPid )
+    {
+        wkgPCB = wkgPCB->stateNext;
+
+        if( wkgPCB == head )
+        {
+            return NULL;
+        }
+    }
+
+    return wkgPCB;
+}
+
+/*
+Name: initReadyHeap
+Process: creates an empty heap with room for capacity processes, 
+            ordered by before
+*/
+void initReadyHeap( ReadyHeapType *heap, int capacity, 
+                            bool (*before)( PCBType *first, PCBType *second ) )
+{
+    heap->count = 0;
+    heap->capacity = capacity;
+    heap->before = before;
+    heap->nodes = (PCBType **)malloc( sizeof( PCBType * ) * capacity );
+}
+
+/*
+Name: insertReadyHeap
+Process: adds a process to the heap, sifting it up to its place
+*/
+void insertReadyHeap( ReadyHeapType *heap, PCBType *pcb )
+{
+    pcb->heapIndex = heap->count;
+    heap->nodes[ heap->count ] = pcb;
+    heap->count++;
+
+    siftReadyHeapUp( heap, pcb->heapIndex );
+}
+
+/*
+Name: insertRunTree
+Process: adds a process to the tree by its virtual runtime, then pid, 
+            rebalancing as needed
+*/
+void insertRunTree( RunTreeType *tree, PCBType *pcb )
+{
+    PCBType *parent = NULL, *wkgPCB = tree->root;
+
+    // find the empty place the process belongs in
+    while( wkgPCB != NULL )
+    {
+        parent = wkgPCB;
+
+        if( runTreeBefore( pcb, wkgPCB ) )
+        {
+            wkgPCB = wkgPCB->treeLeft;
+        }
+        else
+        {
+            wkgPCB = wkgPCB->treeRight;
+        }
+    }
+
+    pcb->treeParent = parent;
+    pcb->treeLeft = NULL;
+    pcb->treeRight = NULL;
+    pcb->treeRed = true;
+
+    if( parent == NULL )
+    {
+        tree->root = pcb;
+    }
+    else if( runTreeBefore( pcb, parent ) )
+    {
+        parent->treeLeft = pcb;
+    }
+    else
+    {
+        parent->treeRight = pcb;
+    }
+
+    tree->count++;
+    fixRunTreeInsert( tree, pcb );
+}
+
+/*
+Name: isRunTreeRed
+Process: returns if the tree node is red, empty (NULL) nodes are black
+*/
+bool isRunTreeRed( PCBType *node )
+{
+    return node != NULL && node->treeRed;
+}
+
+/*
+Name: isRunnableState
+Process: returns if a process in state is ready or running
+*/
+bool isRunnableState( ProcessState state )
+{
+    return state == READY_STATE || state == RUNNING_STATE;
+}
+
+/*
+Name: linkStateList
+Process: adds a process to its manager's list for its state, 
+            keeping the list in pid order, counts it there, 
+         searches back from the list's tail, 
+            as processes mostly join in pid order, 
+         O(n) in the processes with higher pids, fcfs and round robin 
+            select by pid, so the order keeps their selections
+*/
+void linkStateList( PCBType *pcb )
+{
+    PCBManagerType *manager = pcb->manager;
+    PCBType *head = manager->stateHeads[ pcb->state ];
+    PCBType *before;
+
+    manager->stateCounts[ pcb->state ]++;
+
+    // first process in this state
+    if( head == NULL )
+    {
+        pcb->statePrev = pcb;
+        pcb->stateNext = pcb;
+        manager->stateHeads[ pcb->state ] = pcb;
+        return;
+    }
+
+    // find the last process with a lower pid
+    before = head->statePrev;
+    while( before != head && before->pid > pcb->pid )
+    {
+        before = before->statePrev;
+    }
+
+    // lowest pid in the list, it is placed at the tail and becomes the head
+    if( before->pid > pcb->pid )
+    {
+        before = head->statePrev;
+        manager->stateHeads[ pcb->state ] = pcb;
+    }
+
+    pcb->statePrev = before;
+    pcb->stateNext = before->stateNext;
+    before->stateNext->statePrev = pcb;
+    before->stateNext = pcb;
+}
+
+/*
+Name: passBefore
+Process: returns if the first process is ahead of the second in a 
+            stride heap, by pass value, then by pid
+*/
+bool passBefore( PCBType *first, PCBType *second )
+{
+    if( first->passValue != second->passValue )
+    {
+        return first->passValue < second->passValue;
+    }
+
+    return first->pid < second->pid;
+}
+
+/*
+Name: peekReadyHeap
+Process: returns the process at the front of the heap, 
+         NULL if the heap is empty
+*/
+PCBType *peekReadyHeap( ReadyHeapType *heap )
+{
+    if( heap->count == 0 )
+    {
+        return NULL;
+    }
+
+    return heap->nodes[ 0 ];
+}
+
 /*
 Name: prependPCBNode
 Process: places newNode in front of the reference node
@@ -229,21 +853,239 @@ PCBType *prependPCBNode( PCBType *refListNode, PCBType *newNode )
     return refListNode;
 }
 
+/*
+Name: readyBefore
+Process: returns if the first process is ahead of the second in the 
+            ready heap, by remaining time, then by pid
+*/
+bool readyBefore( PCBType *first, PCBType *second )
+{
+    if( first->remainingTotalTime != second->remainingTotalTime )
+    {
+        return first->remainingTotalTime < second->remainingTotalTime;
+    }
+
+    return first->pid < second->pid;
+}
+
+/*
+Name: reducePCBTime
+Process: reduces the process's remaining time by usedTime
+*/
+void reducePCBTime( PCBType *pcb, int usedTime )
+{
+    pcb->remainingTotalTime -= usedTime;
+}
+
+/*
+Name: removeReadyHeap
+Process: removes a process from any position in the heap, 
+         the last node fills its place and is sifted either way
+*/
+void removeReadyHeap( ReadyHeapType *heap, PCBType *pcb )
+{
+    int index = pcb->heapIndex;
+    PCBType *lastNode;
+
+    heap->count--;
+    lastNode = heap->nodes[ heap->count ];
+    pcb->heapIndex = -1;
+
+    // the removed node was last, nothing needs to move
+    if( lastNode == pcb )
+    {
+        return;
+    }
+
+    heap->nodes[ index ] = lastNode;
+    lastNode->heapIndex = index;
+    siftReadyHeapUp( heap, index );
+    siftReadyHeapDown( heap, lastNode->heapIndex );
+}
+
+/*
+Name: removeRunTree
+Process: removes a process from the tree, rebalancing as needed, 
+         its key is not compared, so it may have changed since insertion
+*/
+void removeRunTree( RunTreeType *tree, PCBType *pcb )
+{
+    PCBType *successor, *child, *childParent;
+    bool removedRed = pcb->treeRed;
+
+    // at most one child, the child takes its place
+    if( pcb->treeLeft == NULL || pcb->treeRight == NULL )
+    {
+        child = pcb->treeLeft != NULL ? pcb->treeLeft : pcb->treeRight;
+        childParent = pcb->treeParent;
+        transplantRunTree( tree, pcb, child );
+    }
+
+    // otherwise, the next process in order takes its place
+    else
+    {
+        successor = pcb->treeRight;
+        while( successor->treeLeft != NULL )
+        {
+            successor = successor->treeLeft;
+        }
+
+        removedRed = successor->treeRed;
+        child = successor->treeRight;
+
+        if( successor->treeParent == pcb )
+        {
+            childParent = successor;
+        }
+        else
+        {
+            childParent = successor->treeParent;
+            transplantRunTree( tree, successor, successor->treeRight );
+            successor->treeRight = pcb->treeRight;
+            successor->treeRight->treeParent = successor;
+        }
+
+        transplantRunTree( tree, pcb, successor );
+        successor->treeLeft = pcb->treeLeft;
+        successor->treeLeft->treeParent = successor;
+        successor->treeRed = pcb->treeRed;
+    }
+
+    // removing a black node shortens its paths
+    if( !removedRed )
+    {
+        fixRunTreeRemove( tree, child, childParent );
+    }
+
+    pcb->treeParent = NULL;
+    pcb->treeLeft = NULL;
+    pcb->treeRight = NULL;
+    tree->count--;
+}
+
+/*
+Name: rotateRunTreeLeft
+Process: lifts the node's right child into its place
+*/
+void rotateRunTreeLeft( RunTreeType *tree, PCBType *node )
+{
+    PCBType *child = node->treeRight;
+
+    node->treeRight = child->treeLeft;
+    if( child->treeLeft != NULL )
+    {
+        child->treeLeft->treeParent = node;
+    }
+
+    transplantRunTree( tree, node, child );
+    child->treeLeft = node;
+    node->treeParent = child;
+}
+
+/*
+Name: rotateRunTreeRight
+Process: lifts the node's left child into its place
+*/
+void rotateRunTreeRight( RunTreeType *tree, PCBType *node )
+{
+    PCBType *child = node->treeLeft;
+
+    node->treeLeft = child->treeRight;
+    if( child->treeRight != NULL )
+    {
+        child->treeRight->treeParent = node;
+    }
+
+    transplantRunTree( tree, node, child );
+    child->treeRight = node;
+    node->treeParent = child;
+}
+
+/*
+Name: runTreeBefore
+Process: returns if the first process is ahead of the second in the 
+            run tree, by virtual runtime, then by pid
+*/
+bool runTreeBefore( PCBType *first, PCBType *second )
+{
+    if( first->vruntime != second->vruntime )
+    {
+        return first->vruntime < second->vruntime;
+    }
+
+    return first->pid < second->pid;
+}
+
 /*
 Name: setPCBState
-Process: set's pcbObj's state to newState, 
-         displays the change in state
+Process: changes pcbObj's state to newState as changePCBState, 
+         telling the scheduler
 */
-void setPCBState( PCBType *pcbObj, char *newState )
+void setPCBState( TimerContextType *timer, PCBType *pcbObj, 
+                                                     ProcessState newState )
 {
-    char outputString[ HUGE_STR_LEN ];
-    if( pcbObj != NULL )
+    changePCBState( timer, pcbObj, newState, true );
+}
+
+/*
+Name: siftReadyHeapDown
+Process: moves the node at index down until neither child is ahead of it
+*/
+void siftReadyHeapDown( ReadyHeapType *heap, int index )
+{
+    PCBType *movingNode = heap->nodes[ index ];
+    int childIndex = index * 2 + 1;
+
+    while( childIndex < heap->count )
     {
-        sprintf( outputString, "OS: Process %i set from %s to %s\n", 
-                                        pcbObj->pid, pcbObj->state, newState );
-        copyString( pcbObj->state, newState );
-        output( outputString );
+        // take the child that is further ahead
+        if( childIndex + 1 < heap->count && 
+            heap->before( heap->nodes[ childIndex + 1 ], 
+                                                  heap->nodes[ childIndex ] ) )
+        {
+            childIndex++;
+        }
+
+        if( !heap->before( heap->nodes[ childIndex ], movingNode ) )
+        {
+            break;
+        }
+
+        heap->nodes[ index ] = heap->nodes[ childIndex ];
+        heap->nodes[ index ]->heapIndex = index;
+        index = childIndex;
+        childIndex = index * 2 + 1;
+    }
+
+    heap->nodes[ index ] = movingNode;
+    movingNode->heapIndex = index;
+}
+
+/*
+Name: siftReadyHeapUp
+Process: moves the node at index up until its parent is ahead of it
+*/
+void siftReadyHeapUp( ReadyHeapType *heap, int index )
+{
+    PCBType *movingNode = heap->nodes[ index ];
+    int parentIndex;
+
+    while( index > 0 )
+    {
+        parentIndex = ( index - 1 ) / 2;
+
+        if( !heap->before( movingNode, heap->nodes[ parentIndex ] ) )
+        {
+            break;
+        }
+
+        heap->nodes[ index ] = heap->nodes[ parentIndex ];
+        heap->nodes[ index ]->heapIndex = index;
+        index = parentIndex;
     }
+
+    heap->nodes[ index ] = movingNode;
+    movingNode->heapIndex = index;
 }
 
 /*
@@ -296,7 +1138,89 @@ bool taskDataToString( char *taskStr, PCBType *pcb, bool start )
     return true;
 }
 
+/*
+Name: transplantRunTree
+Process: links replacement (it may be NULL) into node's place 
+            under node's parent
+*/
+void transplantRunTree( RunTreeType *tree, PCBType *node, 
+                                                        PCBType *replacement )
+{
+    if( node->treeParent == NULL )
+    {
+        tree->root = replacement;
+    }
+    else if( node == node->treeParent->treeLeft )
+    {
+        node->treeParent->treeLeft = replacement;
+    }
+    else
+    {
+        node->treeParent->treeRight = replacement;
+    }
+
+    if( replacement != NULL )
+    {
+        replacement->treeParent = node->treeParent;
+    }
+}
+
+/*
+Name: unlinkStateList
+Process: removes a process from its manager's list for its state, 
+         uncounts it there
+*/
+void unlinkStateList( PCBType *pcb )
+{
+    PCBManagerType *manager = pcb->manager;
 
+    manager->stateCounts[ pcb->state ]--;
 
+    // last process in this state
+    if( pcb->stateNext == pcb )
+    {
+        manager->stateHeads[ pcb->state ] = NULL;
+    }
+    else
+    {
+        if( manager->stateHeads[ pcb->state ] == pcb )
+        {
+            manager->stateHeads[ pcb->state ] = pcb->stateNext;
+        }
+
+        pcb->statePrev->stateNext = pcb->stateNext;
+        pcb->stateNext->statePrev = pcb->statePrev;
+    }
+
+    pcb->statePrev = pcb;
+    pcb->stateNext = pcb;
+}
+
+/*
+Name: updateSchedulerQueue
+Process: tells the manager's scheduler when the process starts or 
+            stops being ready or running, oldState is its prior state
+*/
+void updateSchedulerQueue( PCBType *pcb, ProcessState oldState )
+{
+    SchedulerType *scheduler;
+    bool couldRun = isRunnableState( oldState );
+    bool canRun = isRunnableState( pcb->state );
+
+    if( pcb->manager == NULL || pcb->manager->scheduler == NULL )
+    {
+        return;
+    }
+    scheduler = pcb->manager->scheduler;
+
+    if( canRun && !couldRun )
+    {
+        scheduler->ops->enqueue( scheduler, pcb );
+    }
+    else if( !canRun && couldRun )
+    {
+        scheduler->ops->dequeue( scheduler, pcb );
+    }
+}
 
 
@@ -16,6 +16,25 @@ Process: Adds a node toAppend to the end of manager
 */
 void appendNodeToManager( PCBManagerType *manager, PCBType *toAppend );
 
+/*
+Name: changePCBState
+Process: set's pcbObj's state to newState, 
+         moves it to the state list for newState, 
+         tells the scheduler if it became or stopped being runnable, 
+            unless notifyScheduler is false, 
+         records its arrival and adds its turnaround when it exits, 
+         displays the change in state
+*/
+void changePCBState( TimerContextType *timer, PCBType *pcbObj, 
+                             ProcessState newState, bool notifyScheduler );
+
+/*
+Name: checkProcessDeadline
+Process: counts an exiting process that has a deadline, 
+         logs and sums its lateness if it finished after the deadline
+*/
+void checkProcessDeadline( TimerContextType *timer, PCBType *pcb );
+
 /*
 Name: clearPCBList
 Process: removes all nodes from a list, starting at listNode
@@ -30,6 +49,12 @@ Process: erases simulator memory from pcbObj, unlink from list,
 PCBType *clearPCBNode( PCBType *pcbObj );
 
 
+/*
+Name: clearReadyHeap
+Process: frees the heap's node array, leaving it empty
+*/
+void clearReadyHeap( ReadyHeapType *heap );
+
 /*
 Name: createPCBList
 Process: returns NULL, representing an empty list
@@ -39,10 +64,14 @@ PCBType *createPCBList();
 /*
 Name: createPCBManager
 Process: creates a PCBManagerType containing all of the 
-         data in the opCodePtr list
+         data in the opCodePtr list, 
+         timer and outputFormat are the simulation's, 
+            used to log state changes
 */
 PCBManagerType *createPCBManager( OpCodeType *opCodePtr, 
-                                  ConfigDataType *configPtr );
+                                  ConfigDataType *configPtr, 
+                                  TimerContextType *timer, 
+                                  OutputFormatType *outputFormat );
 
 /*
 Name: createPCBNode
@@ -53,6 +82,43 @@ Parameters/Output: wkgOpCodePtr will be pointed at the node
 */
 PCBType *createPCBNode( OpCodeType **wkgOpCodePtr, ConfigDataType *configPtr );
 
+/*
+Name: deadlineBefore
+Process: returns if the first process is ahead of the second in a 
+            deadline heap, by deadline, then by pid, 
+         processes without a deadline follow those with one, 
+         orders the heap only, the pid tie break is not a preemption
+*/
+bool deadlineBefore( PCBType *first, PCBType *second );
+
+/*
+Name: displayDeadlineStats
+Process: displays how many exited processes missed their deadlines, 
+            and by how much, if any process had a deadline
+*/
+void displayDeadlineStats( PCBManagerType *manager );
+
+/*
+Name: firstRunTree
+Process: returns the process with the least virtual runtime, 
+            the lowest pid among equal runtimes, 
+         NULL if the tree is empty
+*/
+PCBType *firstRunTree( RunTreeType *tree );
+
+/*
+Name: fixRunTreeInsert
+Process: restores the red-black rules after the red node was inserted
+*/
+void fixRunTreeInsert( RunTreeType *tree, PCBType *node );
+
+/*
+Name: fixRunTreeRemove
+Process: restores the red-black rules after a black node was removed, 
+            node took its place (it may be NULL) under parent
+*/
+void fixRunTreeRemove( RunTreeType *tree, PCBType *node, PCBType *parent );
+
 /*
 Name: getCycleRate
 Process: calculates the time per cycle for a program
@@ -65,18 +131,152 @@ Process: get's total time PCB requires to finish
 */
 int getPCBTime( PCBType *pcb, ConfigDataType *configPtr );
 
+/*
+Name: getStateName
+Process: returns the display name of a process state, 
+         only needed when the state is logged
+*/
+const char *getStateName( ProcessState state );
+
+/*
+Name: getStateProcessAfter
+Process: returns the first process in the manager's list for state 
+            with a pid above afterPid, 
+         NULL if there is none, 
+         walks the list from its head, O(n) in the processes passed
+*/
+PCBType *getStateProcessAfter( PCBManagerType *manager, ProcessState state, 
+                                                                int afterPid );
+
+/*
+Name: initReadyHeap
+Process: creates an empty heap with room for capacity processes, 
+            ordered by before
+*/
+void initReadyHeap( ReadyHeapType *heap, int capacity, 
+                           bool (*before)( PCBType *first, PCBType *second ) );
+
+/*
+Name: insertReadyHeap
+Process: adds a process to the heap, sifting it up to its place
+*/
+void insertReadyHeap( ReadyHeapType *heap, PCBType *pcb );
+
+/*
+Name: insertRunTree
+Process: adds a process to the tree by its virtual runtime, then pid, 
+            rebalancing as needed
+*/
+void insertRunTree( RunTreeType *tree, PCBType *pcb );
+
+/*
+Name: isRunTreeRed
+Process: returns if the tree node is red, empty (NULL) nodes are black
+*/
+bool isRunTreeRed( PCBType *node );
+
+/*
+Name: isRunnableState
+Process: returns if a process in state is ready or running
+*/
+bool isRunnableState( ProcessState state );
+
+/*
+Name: linkStateList
+Process: adds a process to its manager's list for its state, 
+            keeping the list in pid order, counts it there, 
+         searches back from the list's tail, 
+            as processes mostly join in pid order, 
+         O(n) in the processes with higher pids, fcfs and round robin 
+            select by pid, so the order keeps their selections
+*/
+void linkStateList( PCBType *pcb );
+
+/*
+Name: passBefore
+Process: returns if the first process is ahead of the second in a 
+            stride heap, by pass value, then by pid
+*/
+bool passBefore( PCBType *first, PCBType *second );
+
+/*
+Name: peekReadyHeap
+Process: returns the process at the front of the heap, 
+         NULL if the heap is empty
+*/
+PCBType *peekReadyHeap( ReadyHeapType *heap );
+
 /*
 Name: prependPCBNode
 Process: places newNode in front of the reference node
 */
 PCBType *prependPCBNode( PCBType *refListNode, PCBType *newNode );
 
+/*
+Name: readyBefore
+Process: returns if the first process is ahead of the second in the 
+            ready heap, by remaining time, then by pid
+*/
+bool readyBefore( PCBType *first, PCBType *second );
+
+/*
+Name: reducePCBTime
+Process: reduces the process's remaining time by usedTime
+*/
+void reducePCBTime( PCBType *pcb, int usedTime );
+
+/*
+Name: removeReadyHeap
+Process: removes a process from any position in the heap, 
+         the last node fills its place and is sifted either way
+*/
+void removeReadyHeap( ReadyHeapType *heap, PCBType *pcb );
+
+/*
+Name: removeRunTree
+Process: removes a process from the tree, rebalancing as needed, 
+         its key is not compared, so it may have changed since insertion
+*/
+void removeRunTree( RunTreeType *tree, PCBType *pcb );
+
+/*
+Name: rotateRunTreeLeft
+Process: lifts the node's right child into its place
+*/
+void rotateRunTreeLeft( RunTreeType *tree, PCBType *node );
+
+/*
+Name: rotateRunTreeRight
+Process: lifts the node's left child into its place
+*/
+void rotateRunTreeRight( RunTreeType *tree, PCBType *node );
+
+/*
+Name: runTreeBefore
+Process: returns if the first process is ahead of the second in the 
+            run tree, by virtual runtime, then by pid
+*/
+bool runTreeBefore( PCBType *first, PCBType *second );
+
 /*
 Name: setPCBState
-Process: set's pcbObj's state to newState, 
-         displays the change in state
+Process: changes pcbObj's state to newState as changePCBState, 
+         telling the scheduler
+*/
+void setPCBState( TimerContextType *timer, PCBType *pcbObj, 
+                                                     ProcessState newState );
+
+/*
+Name: siftReadyHeapDown
+Process: moves the node at index down until neither child is ahead of it
 */
-void setPCBState( PCBType *pcbObj, char *newState );
+void siftReadyHeapDown( ReadyHeapType *heap, int index );
+
+/*
+Name: siftReadyHeapUp
+Process: moves the node at index up until its parent is ahead of it
+*/
+void siftReadyHeapUp( ReadyHeapType *heap, int index );
 
 /*
 Name: taskDataToString
@@ -86,6 +286,27 @@ Parameters/Output: requires taskStr has enough memory allocated
 */
 bool taskDataToString( char *taskStr, PCBType *pcb, bool start );
 
+/*
+Name: transplantRunTree
+Process: links replacement (it may be NULL) into node's place 
+            under node's parent
+*/
+void transplantRunTree( RunTreeType *tree, PCBType *node, 
+                                                        PCBType *replacement );
 
-#endif // PCB_H
+/*
+Name: unlinkStateList
+Process: removes a process from its manager's list for its state, 
+         uncounts it there
+*/
+void unlinkStateList( PCBType *pcb );
 
+/*
+Name: updateSchedulerQueue
+Process: tells the manager's scheduler when the process starts or 
+            stops being ready or running, oldState is its prior state
+*/
+void updateSchedulerQueue( PCBType *pcb, ProcessState oldState );
+
+
+#endif // PCB_H
@@ -0,0 +1,1136 @@
+#include "schedops.h"
+
+/*
+A scheduler selects which ready process runs on the cpu.
+Each policy is a set of hooks (SchedulerOpsType, see datatypes.h)
+   called by the simulator and the pcb manager:
+ - init, clear: create and free the policy's private data
+ - enqueue, dequeue: a process starts or stops being ready or running, 
+      called from setPCBState as the state changes
+ - pickNext: returns the process to run next
+ - onTick: called after every cycle the running process completes, 
+      returns if the process used up its time slice
+ - onBlock: called when the running process blocks for I/O
+ - shouldPreempt: called when an interrupt made processes ready, 
+      returns if the running process should give up the cpu at once
+ - report: displays the policy's own statistics at the end of the run
+Policies are found by the name used in the config file, 
+   a new policy needs its hooks and an entry in the scheduler table.
+FCFS and RR take processes in pid order from the manager's ready and
+   running lists; SJF and SRTF keep a ready heap ordered by remaining
+   time. SRTF also preempts the running process when a process 
+   returning from I/O has less time remaining.
+MLFQ keeps a looped run queue per level, linked through the processes. 
+   A process starts at level 0, drops a level each time it uses up its 
+   level's quantum, rises a level when it blocks for I/O, and every 
+   process returns to level 0 at each priority boost.
+CFS keeps a red-black tree ordered by virtual runtime, the msec each 
+   process has run, and runs the process with the least. A process 
+   keeps the cpu for at least the minimum granularity, then gives it 
+   up once another process has run less.
+Stride and lottery give each app a share of the cpu in proportion to 
+   the tickets on its app start line. Stride keeps a heap ordered by 
+   pass value, runs the lowest pass, and advances the running 
+   process's pass by its stride (STRIDE_ONE / tickets) each cycle. 
+   Lottery draws a ticket with a seeded generator each time slice.
+EDF keeps a ready heap ordered by deadline, from the optional deadline 
+   on each app start line, and preempts the running process when a 
+   process due sooner returns from I/O. Processes without a deadline 
+   run after those with one.
+*/
+
+// every policy, the first is the default
+static const SchedulerOpsType SCHEDULERS[] =
+{
+    { "fcfs-n", CPU_SCHED_FCFS_N_CODE, false, 
+      ignoreScheduler, ignoreScheduler, ignoreProcess, ignoreProcess, 
+      fcfsPickNext, neverTimeOut, ignoreProcess, neverPreempt, 
+      ignoreScheduler }, 
+
+    { "sjf-n", CPU_SCHED_SJF_N_CODE, false, 
+      sjfInit, sjfClear, sjfEnqueue, sjfDequeue, 
+      sjfPickNext, sjfOnTick, ignoreProcess, neverPreempt, 
+      ignoreScheduler }, 
+
+    { "srtf-p", CPU_SCHED_SRTF_P_CODE, true, 
+      sjfInit, sjfClear, sjfEnqueue, sjfDequeue, 
+      sjfPickNext, sjfOnTick, ignoreProcess, srtfShouldPreempt, 
+      ignoreScheduler }, 
+
+    { "fcfs-p", CPU_SCHED_FCFS_P_CODE, true, 
+      ignoreScheduler, ignoreScheduler, ignoreProcess, ignoreProcess, 
+      fcfsPickNext, neverTimeOut, ignoreProcess, neverPreempt, 
+      ignoreScheduler }, 
+
+    { "rr-p", CPU_SCHED_RR_P_CODE, true, 
+      ignoreScheduler, ignoreScheduler, ignoreProcess, ignoreProcess, 
+      rrPickNext, rrOnTick, ignoreProcess, neverPreempt, 
+      ignoreScheduler }, 
+
+    { "mlfq-p", CPU_SCHED_MLFQ_P_CODE, true, 
+      mlfqInit, mlfqClear, mlfqEnqueue, mlfqDequeue, 
+      mlfqPickNext, mlfqOnTick, mlfqOnBlock, mlfqShouldPreempt, 
+      mlfqReport }, 
+
+    { "cfs-p", CPU_SCHED_CFS_P_CODE, true, 
+      cfsInit, cfsClear, cfsEnqueue, cfsDequeue, 
+      cfsPickNext, cfsOnTick, ignoreProcess, cfsShouldPreempt, 
+      cfsReport }, 
+
+    { "stride-p", CPU_SCHED_STRIDE_P_CODE, true, 
+      shareInit, shareClear, shareEnqueue, shareDequeue, 
+      stridePickNext, strideOnTick, ignoreProcess, neverPreempt, 
+      shareReport }, 
+
+    { "lottery-p", CPU_SCHED_LOTTERY_P_CODE, true, 
+      shareInit, shareClear, shareEnqueue, shareDequeue, 
+      lotteryPickNext, lotteryOnTick, ignoreProcess, neverPreempt, 
+      shareReport }, 
+
+    { "edf-p", CPU_SCHED_EDF_P_CODE, true, 
+      edfInit, sjfClear, sjfEnqueue, sjfDequeue, 
+      sjfPickNext, neverTimeOut, ignoreProcess, edfShouldPreempt, 
+      ignoreScheduler }
+};
+#define NUM_SCHEDULERS \
+            ( (int)( sizeof( SCHEDULERS ) / sizeof( SchedulerOpsType ) ) )
+
+/*
+Name: appendRunQueue
+Process: adds a process to the tail of the looped run queue at head
+*/
+void appendRunQueue( PCBType **head, PCBType *pcb )
+{
+    if( *head == NULL )
+    {
+        pcb->queuePrev = pcb;
+        pcb->queueNext = pcb;
+        *head = pcb;
+        return;
+    }
+
+    pcb->queuePrev = (*head)->queuePrev;
+    pcb->queueNext = *head;
+    (*head)->queuePrev->queueNext = pcb;
+    (*head)->queuePrev = pcb;
+}
+
+/*
+Name: cfsClear
+Process: frees the run tree data, the processes are not freed
+*/
+void cfsClear( SchedulerType *scheduler )
+{
+    free( scheduler->policyData );
+    scheduler->policyData = NULL;
+}
+
+/*
+Name: cfsDequeue
+Process: removes the process from the run tree
+*/
+void cfsDequeue( SchedulerType *scheduler, PCBType *pcb )
+{
+    CFSDataType *cfs = (CFSDataType *)scheduler->policyData;
+
+    removeRunTree( &cfs->tree, pcb );
+
+    if( cfs->slicePcb == pcb )
+    {
+        cfs->slicePcb = NULL;
+    }
+}
+
+/*
+Name: cfsEnqueue
+Process: adds the process to the run tree, a process returning from 
+            I/O or starting late is raised to the least virtual runtime 
+            so it cannot claim the cpu for the time it was away
+*/
+void cfsEnqueue( SchedulerType *scheduler, PCBType *pcb )
+{
+    CFSDataType *cfs = (CFSDataType *)scheduler->policyData;
+
+    if( pcb->vruntime < cfs->minVruntime )
+    {
+        pcb->vruntime = cfs->minVruntime;
+    }
+
+    insertRunTree( &cfs->tree, pcb );
+}
+
+/*
+Name: cfsInit
+Process: creates the empty run tree
+*/
+void cfsInit( SchedulerType *scheduler )
+{
+    CFSDataType *cfs = (CFSDataType *)malloc( sizeof( CFSDataType ) );
+
+    cfs->tree.root = NULL;
+    cfs->tree.count = 0;
+    cfs->minVruntime = 0;
+    cfs->granularityMSec = scheduler->configPtr->cfsGranularityMSec;
+    cfs->slicePcb = NULL;
+    cfs->sliceMSec = 0;
+    cfs->sliceEndCount = 0;
+
+    scheduler->policyData = cfs;
+}
+
+/*
+Name: cfsOnTick
+Process: moves the process to its place in the run tree for its new 
+            virtual runtime (added by runCycle), 
+         returns if it has run the minimum granularity and another 
+            process now has less virtual runtime
+*/
+bool cfsOnTick( SchedulerType *scheduler, PCBType *pcb )
+{
+    CFSDataType *cfs = (CFSDataType *)scheduler->policyData;
+    PCBType *firstPCB;
+    bool sliceEnded;
+
+    // the key grew in place, so the process is re-inserted
+    removeRunTree( &cfs->tree, pcb );
+    insertRunTree( &cfs->tree, pcb );
+
+    // the least virtual runtime only moves forward
+    firstPCB = firstRunTree( &cfs->tree );
+    if( firstPCB->vruntime > cfs->minVruntime )
+    {
+        cfs->minVruntime = firstPCB->vruntime;
+    }
+
+    if( cfs->slicePcb != pcb )
+    {
+        cfs->slicePcb = pcb;
+        cfs->sliceMSec = 0;
+    }
+    cfs->sliceMSec += getCycleRate( pcb->programCounter, 
+                                                      scheduler->configPtr );
+
+    sliceEnded = cfs->sliceMSec >= cfs->granularityMSec && firstPCB != pcb;
+
+    if( sliceEnded )
+    {
+        cfs->slicePcb = NULL;
+        cfs->sliceEndCount++;
+    }
+
+    return sliceEnded;
+}
+
+/*
+Name: cfsPickNext
+Process: returns the ready or running process with the least virtual 
+            runtime, the lowest pid among equal runtimes
+*/
+PCBType *cfsPickNext( SchedulerType *scheduler )
+{
+    return firstRunTree( &( (CFSDataType *)scheduler->policyData )->tree );
+}
+
+/*
+Name: cfsReport
+Process: displays the minimum granularity, the time slices it ended, 
+            and the final least virtual runtime
+*/
+void cfsReport( SchedulerType *scheduler )
+{
+    CFSDataType *cfs = (CFSDataType *)scheduler->policyData;
+    char outputString[ HUGE_STR_LEN ];
+
+    sprintf( outputString, 
+             "CFS: minimum granularity %d ms, %d time slices ended, "
+             "least virtual runtime %ld ms\n", 
+             cfs->granularityMSec, cfs->sliceEndCount, cfs->minVruntime );
+    outputDirectly( scheduler->manager->outputFormat, outputString );
+}
+
+/*
+Name: cfsShouldPreempt
+Process: returns if a ready process trails the running process's 
+            virtual runtime by more than the minimum granularity
+*/
+bool cfsShouldPreempt( SchedulerType *scheduler, PCBType *current )
+{
+    CFSDataType *cfs = (CFSDataType *)scheduler->policyData;
+    PCBType *firstPCB = firstRunTree( &cfs->tree );
+
+    return firstPCB != NULL && firstPCB != current 
+        && firstPCB->vruntime + cfs->granularityMSec < current->vruntime;
+}
+
+/*
+Name: clearScheduler
+Process: frees the scheduler and its policy data, 
+         detaches it from its manager
+*/
+void clearScheduler( SchedulerType *scheduler )
+{
+    scheduler->ops->clear( scheduler );
+    scheduler->manager->scheduler = NULL;
+    free( scheduler );
+}
+
+/*
+Name: createScheduler
+Process: creates the scheduler for the config's cpu schedule code, 
+            attached to the manager, 
+         must be created before any process becomes ready
+*/
+SchedulerType *createScheduler( PCBManagerType *manager, 
+                                                   ConfigDataType *configPtr )
+{
+    SchedulerType *scheduler = (SchedulerType *)malloc( sizeof( SchedulerType ) );
+
+    scheduler->ops = findSchedulerByCode( configPtr->cpuSchedCode );
+    scheduler->manager = manager;
+    scheduler->configPtr = configPtr;
+    scheduler->policyData = NULL;
+    scheduler->preemptionCount = 0;
+
+    scheduler->ops->init( scheduler );
+    manager->scheduler = scheduler;
+
+    return scheduler;
+}
+
+/*
+Name: displaySchedulerStats
+Process: for a preemptive policy, displays the policy, the average 
+            turnaround of the exited processes, and how many times 
+            a process was preempted, 
+         then displays the policy's own report
+*/
+void displaySchedulerStats( SchedulerType *scheduler )
+{
+    char outputString[ HUGE_STR_LEN ];
+    PCBManagerType *manager = scheduler->manager;
+    int exitedCount = manager->stateCounts[ EXIT_STATE ];
+    double averageMSec = 0.0;
+
+    if( exitedCount > 0 )
+    {
+        averageMSec = (double)manager->totalTurnaroundUSec 
+                                                    / exitedCount / 1000.0;
+    }
+
+    // a non-preemptive run keeps the baseline output
+    if( scheduler->ops->preemptive )
+    {
+        sprintf( outputString, 
+                 "CPU scheduling %s: average turnaround %.3f ms, "
+                 "%d preemptions\n", 
+                 scheduler->ops->name, averageMSec, 
+                 scheduler->preemptionCount );
+        outputDirectly( scheduler->manager->outputFormat, outputString );
+    }
+
+    scheduler->ops->report( scheduler );
+}
+
+/*
+Name: edfInit
+Process: creates a deadline heap with room for every process
+*/
+void edfInit( SchedulerType *scheduler )
+{
+    ReadyHeapType *heap = (ReadyHeapType *)malloc( sizeof( ReadyHeapType ) );
+
+    initReadyHeap( heap, scheduler->manager->unusedPid, deadlineBefore );
+    scheduler->policyData = heap;
+}
+
+/*
+Name: edfShouldPreempt
+Process: returns if a ready process with a deadline is due strictly 
+            before the running process, or the running process has none, 
+         ties and processes without deadlines never preempt
+*/
+bool edfShouldPreempt( SchedulerType *scheduler, PCBType *current )
+{
+    ReadyHeapType *heap = (ReadyHeapType *)scheduler->policyData;
+    PCBType *earliest = peekReadyHeap( heap );
+
+    if( earliest == NULL || earliest == current 
+                                         || earliest->relativeDeadline == 0 )
+    {
+        return false;
+    }
+
+    return current->relativeDeadline == 0 
+        || earliest->deadlineTime < current->deadlineTime;
+}
+
+/*
+Name: fcfsPickNext
+Process: returns the ready or running process with the lowest pid
+*/
+PCBType *fcfsPickNext( SchedulerType *scheduler )
+{
+    return getNextReadyProcess( scheduler->manager, NOT_IN_USE );
+}
+
+/*
+Name: findSchedulerByCode
+Process: returns the policy with the config code, FCFS-N if none has it
+*/
+const SchedulerOpsType *findSchedulerByCode( ConfigDataCodes schedCode )
+{
+    int index;
+
+    for( index = 0; index < NUM_SCHEDULERS; index++ )
+    {
+        if( SCHEDULERS[ index ].schedCode == schedCode )
+        {
+            return &SCHEDULERS[ index ];
+        }
+    }
+
+    return &SCHEDULERS[ 0 ];
+}
+
+/*
+Name: findSchedulerByName
+Process: returns the policy with the lower case config name, 
+         NULL if there is none
+*/
+const SchedulerOpsType *findSchedulerByName( const char *lowerCaseStr )
+{
+    int index;
+
+    for( index = 0; index < NUM_SCHEDULERS; index++ )
+    {
+        if( compareString( lowerCaseStr, SCHEDULERS[ index ].name ) == 0 )
+        {
+            return &SCHEDULERS[ index ];
+        }
+    }
+
+    return NULL;
+}
+
+/*
+Name: getNextReadyProcess
+Process: returns the ready or running process following afterPid
+            in pid order, wrapping around to the lowest pid, 
+         afterPid of NOT_IN_USE starts from the lowest pid, 
+         returns NULL if none found
+*/
+PCBType *getNextReadyProcess( PCBManagerType *manager, int afterPid )
+{
+    PCBType *readyPCB, *runningPCB;
+
+    // only the ready and running lists are searched
+    readyPCB = getStateProcessAfter( manager, READY_STATE, afterPid );
+    runningPCB = getStateProcessAfter( manager, RUNNING_STATE, afterPid );
+
+    // none follow afterPid, wrap around to the lowest pid
+    if( readyPCB == NULL && runningPCB == NULL && afterPid != NOT_IN_USE )
+    {
+        return getNextReadyProcess( manager, NOT_IN_USE );
+    }
+
+    // take whichever comes first
+    if( readyPCB == NULL || 
+        ( runningPCB != NULL && runningPCB->pid < readyPCB->pid ) )
+    {
+        return runningPCB;
+    }
+
+    return readyPCB;
+}
+
+/*
+Name: ignoreProcess
+Process: hook for policies that need nothing done for the event
+*/
+void ignoreProcess( SchedulerType *scheduler, PCBType *pcb )
+{
+}
+
+/*
+Name: ignoreScheduler
+Process: init and clear hook for policies without private data
+*/
+void ignoreScheduler( SchedulerType *scheduler )
+{
+}
+
+/*
+Name: lotteryOnTick
+Process: charges the cycle to the process, 
+         returns if the process has run its quantum of cycles in a row
+*/
+bool lotteryOnTick( SchedulerType *scheduler, PCBType *pcb )
+{
+    shareChargeCycle( scheduler, pcb );
+
+    return rrOnTick( scheduler, pcb );
+}
+
+/*
+Name: lotteryPickNext
+Process: draws a ticket among the ready and running processes, 
+            returns the process holding it, 
+         NULL if none are ready
+*/
+PCBType *lotteryPickNext( SchedulerType *scheduler )
+{
+    ShareDataType *share = (ShareDataType *)scheduler->policyData;
+    long totalTickets = 0, winner;
+    int index;
+
+    for( index = 0; index < share->heap.count; index++ )
+    {
+        totalTickets += share->heap.nodes[ index ]->shareTickets;
+    }
+
+    if( totalTickets == 0 )
+    {
+        return NULL;
+    }
+
+    winner = (long)( lotteryRandom( share ) % (unsigned long)totalTickets );
+    share->drawCount++;
+
+    // walk the processes until the winning ticket is reached
+    for( index = 0; winner >= share->heap.nodes[ index ]->shareTickets; 
+                                                                    index++ )
+    {
+        winner -= share->heap.nodes[ index ]->shareTickets;
+    }
+
+    return share->heap.nodes[ index ];
+}
+
+/*
+Name: lotteryRandom
+Process: returns the next value of the policy's own xorshift generator, 
+            so a seed draws the same tickets on every platform
+*/
+unsigned long lotteryRandom( ShareDataType *share )
+{
+    unsigned long state = share->randomState;
+
+    state ^= ( state << 13 ) & 0xFFFFFFFFUL;
+    state ^= state >> 17;
+    state ^= ( state << 5 ) & 0xFFFFFFFFUL;
+
+    share->randomState = state;
+    return state;
+}
+
+/*
+Name: mlfqBoost
+Process: returns every process to level 0 with a fresh quantum, 
+            the lower levels join level 0 in level order
+*/
+void mlfqBoost( SchedulerType *scheduler )
+{
+    MLFQDataType *mlfq = (MLFQDataType *)scheduler->policyData;
+    PCBType *wkgPCB, *blockedHead;
+    int level;
+
+    // processes already at level 0 restart their quantum
+    wkgPCB = mlfq->levelHeads[ 0 ];
+    if( wkgPCB != NULL )
+    {
+        do
+        {
+            wkgPCB->queueCycles = 0;
+            wkgPCB = wkgPCB->queueNext;
+        } while( wkgPCB != mlfq->levelHeads[ 0 ] );
+    }
+
+    // every lower level is emptied onto level 0
+    for( level = 1; level < mlfq->levelCount; level++ )
+    {
+        while( mlfq->levelHeads[ level ] != NULL )
+        {
+            mlfqMoveLevel( mlfq, mlfq->levelHeads[ level ], 0 );
+        }
+    }
+
+    // processes waiting on I/O come back at level 0
+    blockedHead = scheduler->manager->stateHeads[ BLOCKED_STATE ];
+    wkgPCB = blockedHead;
+    if( wkgPCB != NULL )
+    {
+        do
+        {
+            wkgPCB->queueLevel = 0;
+            wkgPCB->queueCycles = 0;
+            wkgPCB = wkgPCB->stateNext;
+        } while( wkgPCB != blockedHead );
+    }
+
+    mlfq->cyclesSinceBoost = 0;
+    mlfq->boostCount++;
+    output( scheduler->manager->outputFormat, scheduler->manager->timer, 
+                         "OS: MLFQ priority boost, all processes to level 0\n" );
+}
+
+/*
+Name: mlfqClear
+Process: frees the run queues, the processes are not freed
+*/
+void mlfqClear( SchedulerType *scheduler )
+{
+    free( scheduler->policyData );
+    scheduler->policyData = NULL;
+}
+
+/*
+Name: mlfqDequeue
+Process: removes the process from its level's run queue
+*/
+void mlfqDequeue( SchedulerType *scheduler, PCBType *pcb )
+{
+    MLFQDataType *mlfq = (MLFQDataType *)scheduler->policyData;
+
+    removeRunQueue( &mlfq->levelHeads[ pcb->queueLevel ], pcb );
+}
+
+/*
+Name: mlfqEnqueue
+Process: adds the process to the tail of its level's run queue, 
+         the running process shown blocked for an interrupt is not 
+            removed and added again, so it keeps its place in the level
+*/
+void mlfqEnqueue( SchedulerType *scheduler, PCBType *pcb )
+{
+    MLFQDataType *mlfq = (MLFQDataType *)scheduler->policyData;
+
+    appendRunQueue( &mlfq->levelHeads[ pcb->queueLevel ], pcb );
+}
+
+/*
+Name: mlfqInit
+Process: creates the empty run queues, 
+         a level without a configured quantum uses twice the quantum 
+            of the level above it, starting from Quantum Time
+*/
+void mlfqInit( SchedulerType *scheduler )
+{
+    MLFQDataType *mlfq = (MLFQDataType *)malloc( sizeof( MLFQDataType ) );
+    ConfigDataType *configPtr = scheduler->configPtr;
+    int level, quantum = configPtr->quantumCycles;
+
+    // a quantum of 0 cycles would never run a process
+    if( quantum < 1 )
+    {
+        quantum = 1;
+    }
+
+    mlfq->levelCount = configPtr->mlfqLevels;
+    mlfq->boostCycles = configPtr->mlfqBoostCycles;
+    mlfq->cyclesSinceBoost = 0;
+    mlfq->demotionCount = 0;
+    mlfq->promotionCount = 0;
+    mlfq->boostCount = 0;
+
+    for( level = 0; level < MAX_MLFQ_LEVELS; level++ )
+    {
+        if( configPtr->mlfqQuanta[ level ] > 0 )
+        {
+            quantum = configPtr->mlfqQuanta[ level ];
+        }
+        else if( level > 0 )
+        {
+            quantum *= 2;
+        }
+
+        mlfq->levelHeads[ level ] = NULL;
+        mlfq->quanta[ level ] = quantum;
+        mlfq->levelCycles[ level ] = 0;
+    }
+
+    scheduler->policyData = mlfq;
+}
+
+/*
+Name: mlfqMoveLevel
+Process: moves a queued process to the tail of level's run queue 
+            with a fresh quantum
+*/
+void mlfqMoveLevel( MLFQDataType *mlfq, PCBType *pcb, int level )
+{
+    removeRunQueue( &mlfq->levelHeads[ pcb->queueLevel ], pcb );
+    pcb->queueLevel = level;
+    pcb->queueCycles = 0;
+    appendRunQueue( &mlfq->levelHeads[ level ], pcb );
+}
+
+/*
+Name: mlfqOnBlock
+Process: raises a process blocking for I/O one level, 
+            so it returns from I/O ahead of the cpu bound processes
+*/
+void mlfqOnBlock( SchedulerType *scheduler, PCBType *pcb )
+{
+    MLFQDataType *mlfq = (MLFQDataType *)scheduler->policyData;
+    char outputString[ HUGE_STR_LEN ];
+
+    if( pcb->queueLevel > 0 )
+    {
+        mlfqMoveLevel( mlfq, pcb, pcb->queueLevel - 1 );
+        mlfq->promotionCount++;
+
+        sprintf( outputString, "OS: Process %i promoted to MLFQ level %i\n", 
+                                                  pcb->pid, pcb->queueLevel );
+        output( scheduler->manager->outputFormat, 
+                                     scheduler->manager->timer, outputString );
+    }
+}
+
+/*
+Name: mlfqOnTick
+Process: counts the cycle against the process's level quantum, 
+         a process that used up its quantum drops a level, 
+            or rejoins the tail of the lowest level, 
+         boosts every process once the boost interval has run, 
+         returns if the process used up its quantum
+*/
+bool mlfqOnTick( SchedulerType *scheduler, PCBType *pcb )
+{
+    MLFQDataType *mlfq = (MLFQDataType *)scheduler->policyData;
+    char outputString[ HUGE_STR_LEN ];
+    bool sliceEnded;
+
+    mlfq->levelCycles[ pcb->queueLevel ]++;
+    pcb->queueCycles++;
+    sliceEnded = pcb->queueCycles >= mlfq->quanta[ pcb->queueLevel ];
+
+    if( sliceEnded && pcb->queueLevel < mlfq->levelCount - 1 )
+    {
+        mlfqMoveLevel( mlfq, pcb, pcb->queueLevel + 1 );
+        mlfq->demotionCount++;
+
+        sprintf( outputString, "OS: Process %i demoted to MLFQ level %i\n", 
+                                                  pcb->pid, pcb->queueLevel );
+        output( scheduler->manager->outputFormat, 
+                                     scheduler->manager->timer, outputString );
+    }
+    else if( sliceEnded )
+    {
+        mlfqMoveLevel( mlfq, pcb, pcb->queueLevel );
+    }
+
+    mlfq->cyclesSinceBoost++;
+    if( mlfq->boostCycles > 0 && mlfq->cyclesSinceBoost >= mlfq->boostCycles )
+    {
+        mlfqBoost( scheduler );
+    }
+
+    return sliceEnded;
+}
+
+/*
+Name: mlfqPickNext
+Process: returns the process at the head of the highest non-empty level
+*/
+PCBType *mlfqPickNext( SchedulerType *scheduler )
+{
+    MLFQDataType *mlfq = (MLFQDataType *)scheduler->policyData;
+    int level;
+
+    for( level = 0; level < mlfq->levelCount; level++ )
+    {
+        if( mlfq->levelHeads[ level ] != NULL )
+        {
+            return mlfq->levelHeads[ level ];
+        }
+    }
+
+    return NULL;
+}
+
+/*
+Name: mlfqReport
+Process: displays the quantum and the share of cycles run at each 
+            level, and the moves between levels
+*/
+void mlfqReport( SchedulerType *scheduler )
+{
+    MLFQDataType *mlfq = (MLFQDataType *)scheduler->policyData;
+    char outputString[ HUGE_STR_LEN ];
+    long totalCycles = 0;
+    int level;
+
+    for( level = 0; level < mlfq->levelCount; level++ )
+    {
+        totalCycles += mlfq->levelCycles[ level ];
+    }
+
+    for( level = 0; level < mlfq->levelCount; level++ )
+    {
+        sprintf( outputString, 
+                 "MLFQ level %d: quantum %d cycles, ran %ld cycles (%.1f%%)\n", 
+                 level, mlfq->quanta[ level ], mlfq->levelCycles[ level ], 
+                 totalCycles > 0 ? 100.0 * mlfq->levelCycles[ level ] 
+                                                         / totalCycles : 0.0 );
+        outputDirectly( scheduler->manager->outputFormat, outputString );
+    }
+
+    sprintf( outputString, "MLFQ: %d demotions, %d promotions, %d boosts\n", 
+             mlfq->demotionCount, mlfq->promotionCount, mlfq->boostCount );
+    outputDirectly( scheduler->manager->outputFormat, outputString );
+}
+
+/*
+Name: mlfqShouldPreempt
+Process: returns if a process is ready at a higher level than the 
+            running process
+*/
+bool mlfqShouldPreempt( SchedulerType *scheduler, PCBType *current )
+{
+    MLFQDataType *mlfq = (MLFQDataType *)scheduler->policyData;
+    int level;
+
+    for( level = 0; level < current->queueLevel; level++ )
+    {
+        if( mlfq->levelHeads[ level ] != NULL )
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/*
+Name: neverPreempt
+Process: shouldPreempt hook for policies that let the running process 
+            keep the cpu through interrupts
+*/
+bool neverPreempt( SchedulerType *scheduler, PCBType *current )
+{
+    return false;
+}
+
+/*
+Name: neverTimeOut
+Process: onTick hook for policies that run a process until it blocks
+*/
+bool neverTimeOut( SchedulerType *scheduler, PCBType *pcb )
+{
+    return false;
+}
+
+/*
+Name: removeRunQueue
+Process: removes a process from the looped run queue at head
+*/
+void removeRunQueue( PCBType **head, PCBType *pcb )
+{
+    if( pcb->queueNext == pcb )
+    {
+        *head = NULL;
+    }
+    else
+    {
+        if( *head == pcb )
+        {
+            *head = pcb->queueNext;
+        }
+
+        pcb->queuePrev->queueNext = pcb->queueNext;
+        pcb->queueNext->queuePrev = pcb->queuePrev;
+    }
+
+    pcb->queuePrev = pcb;
+    pcb->queueNext = pcb;
+}
+
+/*
+Name: rrOnTick
+Process: returns if the process has run its quantum of cycles in a row
+*/
+bool rrOnTick( SchedulerType *scheduler, PCBType *pcb )
+{
+    return pcb->consecutiveCycles >= scheduler->configPtr->quantumCycles;
+}
+
+/*
+Name: rrPickNext
+Process: returns the ready or running process after the current one
+            in pid order, wrapping around, 
+         the lowest pid if none has run yet
+*/
+PCBType *rrPickNext( SchedulerType *scheduler )
+{
+    PCBType *currentPcb = scheduler->manager->currentPcb;
+
+    if( currentPcb == NULL )
+    {
+        return getNextReadyProcess( scheduler->manager, NOT_IN_USE );
+    }
+
+    return getNextReadyProcess( scheduler->manager, currentPcb->pid );
+}
+
+/*
+Name: shareChargeCycle
+Process: adds the cycle's msec to the process's cpu time, and the 
+            cycle's msec per runnable ticket to the entitlement clock
+*/
+void shareChargeCycle( SchedulerType *scheduler, PCBType *pcb )
+{
+    ShareDataType *share = (ShareDataType *)scheduler->policyData;
+    int cycleTime = getCycleRate( pcb->programCounter, scheduler->configPtr );
+
+    share->apps[ pcb->pid ].cpuMSec += cycleTime;
+    share->ticketMSec += (double)cycleTime / share->runnableTickets;
+}
+
+/*
+Name: shareClear
+Process: frees the pass heap and the per-app records
+*/
+void shareClear( SchedulerType *scheduler )
+{
+    ShareDataType *share = (ShareDataType *)scheduler->policyData;
+
+    clearReadyHeap( &share->heap );
+    free( share->apps );
+    free( share );
+    scheduler->policyData = NULL;
+}
+
+/*
+Name: shareDequeue
+Process: removes the process from the pass heap, 
+         adds the cpu time its tickets earned while it could run 
+            to its target
+*/
+void shareDequeue( SchedulerType *scheduler, PCBType *pcb )
+{
+    ShareDataType *share = (ShareDataType *)scheduler->policyData;
+    ShareRecordType *app = &share->apps[ pcb->pid ];
+
+    removeReadyHeap( &share->heap, pcb );
+    share->runnableTickets -= pcb->shareTickets;
+
+    app->targetMSec += 
+                 ( share->ticketMSec - app->joinTicketMSec ) * app->tickets;
+}
+
+/*
+Name: shareEnqueue
+Process: adds the process to the pass heap, a process returning from 
+            I/O or starting late is raised to the global pass 
+            so it cannot claim the cpu for the time it was away, 
+         starts timing its target from the entitlement clock
+*/
+void shareEnqueue( SchedulerType *scheduler, PCBType *pcb )
+{
+    ShareDataType *share = (ShareDataType *)scheduler->policyData;
+    ShareRecordType *app = &share->apps[ pcb->pid ];
+
+    if( pcb->passValue < share->globalPass )
+    {
+        pcb->passValue = share->globalPass;
+    }
+
+    insertReadyHeap( &share->heap, pcb );
+    share->runnableTickets += pcb->shareTickets;
+
+    app->tickets = pcb->shareTickets;
+    app->joinTicketMSec = share->ticketMSec;
+}
+
+/*
+Name: shareInit
+Process: creates a pass heap and per-app records with room for 
+            every process, seeds the lottery generator
+*/
+void shareInit( SchedulerType *scheduler )
+{
+    ShareDataType *share = (ShareDataType *)malloc( sizeof( ShareDataType ) );
+    int processCount = scheduler->manager->unusedPid;
+    int index;
+
+    initReadyHeap( &share->heap, processCount, passBefore );
+    share->globalPass = 0;
+    share->runnableTickets = 0;
+    share->ticketMSec = 0.0;
+    share->drawCount = 0;
+    share->apps = (ShareRecordType *)malloc( sizeof( ShareRecordType ) 
+                                                             * processCount );
+
+    for( index = 0; index < processCount; index++ )
+    {
+        share->apps[ index ].tickets = 0;
+        share->apps[ index ].cpuMSec = 0;
+        share->apps[ index ].targetMSec = 0.0;
+        share->apps[ index ].joinTicketMSec = 0.0;
+    }
+
+    // xorshift never leaves a zero state
+    share->randomState = 
+              (unsigned long)scheduler->configPtr->lotterySeed & 0xFFFFFFFFUL;
+    if( share->randomState == 0 )
+    {
+        share->randomState = DEFAULT_LOTTERY_SEED;
+    }
+
+    scheduler->policyData = share;
+}
+
+/*
+Name: shareReport
+Process: displays each app's tickets, the cpu time its tickets earned 
+            while it could run (its target), and the cpu time it got
+*/
+void shareReport( SchedulerType *scheduler )
+{
+    ShareDataType *share = (ShareDataType *)scheduler->policyData;
+    ShareRecordType *app;
+    char outputString[ HUGE_STR_LEN ];
+    int index;
+
+    for( index = 0; index < share->heap.capacity; index++ )
+    {
+        app = &share->apps[ index ];
+
+        if( app->tickets > 0 )
+        {
+            sprintf( outputString, 
+                     "Process %d share: %d tickets, target %.1f ms, "
+                     "achieved %ld ms (%.1f%%)\n", 
+                     index, app->tickets, app->targetMSec, app->cpuMSec, 
+                     app->targetMSec > 0.0 ? 100.0 * app->cpuMSec 
+                                                 / app->targetMSec : 0.0 );
+            outputDirectly( scheduler->manager->outputFormat, outputString );
+        }
+    }
+
+    if( scheduler->ops->schedCode == CPU_SCHED_LOTTERY_P_CODE )
+    {
+        sprintf( outputString, "Lottery: %d draws\n", share->drawCount );
+        outputDirectly( scheduler->manager->outputFormat, outputString );
+    }
+}
+
+/*
+Name: sjfClear
+Process: frees the ready heap, also used by edf
+*/
+void sjfClear( SchedulerType *scheduler )
+{
+    clearReadyHeap( (ReadyHeapType *)scheduler->policyData );
+    free( scheduler->policyData );
+    scheduler->policyData = NULL;
+}
+
+/*
+Name: sjfDequeue
+Process: removes the process from the ready heap
+*/
+void sjfDequeue( SchedulerType *scheduler, PCBType *pcb )
+{
+    removeReadyHeap( (ReadyHeapType *)scheduler->policyData, pcb );
+}
+
+/*
+Name: sjfEnqueue
+Process: adds the process to the ready heap
+*/
+void sjfEnqueue( SchedulerType *scheduler, PCBType *pcb )
+{
+    insertReadyHeap( (ReadyHeapType *)scheduler->policyData, pcb );
+}
+
+/*
+Name: sjfInit
+Process: creates a ready heap with room for every process
+*/
+void sjfInit( SchedulerType *scheduler )
+{
+    ReadyHeapType *heap = (ReadyHeapType *)malloc( sizeof( ReadyHeapType ) );
+
+    initReadyHeap( heap, scheduler->manager->unusedPid, readyBefore );
+    scheduler->policyData = heap;
+}
+
+/*
+Name: sjfOnTick
+Process: moves the process up the ready heap as its remaining time
+            drops (decrease-key), never ends its slice
+*/
+bool sjfOnTick( SchedulerType *scheduler, PCBType *pcb )
+{
+    if( pcb->heapIndex >= 0 )
+    {
+        siftReadyHeapUp( (ReadyHeapType *)scheduler->policyData, 
+                                                            pcb->heapIndex );
+    }
+
+    return false;
+}
+
+/*
+Name: sjfPickNext
+Process: returns the ready or running process at the front of the 
+            ready heap, the least remaining time for sjf and srtf, 
+            the earliest deadline for edf
+*/
+PCBType *sjfPickNext( SchedulerType *scheduler )
+{
+    return peekReadyHeap( (ReadyHeapType *)scheduler->policyData );
+}
+
+/*
+Name: srtfShouldPreempt
+Process: returns if a ready process has less time remaining than the 
+            running process
+*/
+bool srtfShouldPreempt( SchedulerType *scheduler, PCBType *current )
+{
+    PCBType *shortest = peekReadyHeap( (ReadyHeapType *)scheduler->policyData );
+
+    return shortest != NULL && shortest != current 
+              && shortest->remainingTotalTime < current->remainingTotalTime;
+}
+
+/*
+Name: strideOnTick
+Process: charges the cycle to the process, advances its pass by its 
+            stride and moves it down the pass heap, 
+         returns if it has run its quantum and another process now 
+            has a lower pass
+*/
+bool strideOnTick( SchedulerType *scheduler, PCBType *pcb )
+{
+    ShareDataType *share = (ShareDataType *)scheduler->policyData;
+    PCBType *firstPCB;
+
+    shareChargeCycle( scheduler, pcb );
+    pcb->passValue += STRIDE_ONE / pcb->shareTickets;
+    siftReadyHeapDown( &share->heap, pcb->heapIndex );
+
+    // the global pass only moves forward
+    firstPCB = peekReadyHeap( &share->heap );
+    if( firstPCB->passValue > share->globalPass )
+    {
+        share->globalPass = firstPCB->passValue;
+    }
+
+    return pcb->consecutiveCycles >= scheduler->configPtr->quantumCycles 
+        && firstPCB != pcb;
+}
+
+/*
+Name: stridePickNext
+Process: returns the ready or running process with the lowest pass, 
+            the lowest pid among equal passes
+*/
+PCBType *stridePickNext( SchedulerType *scheduler )
+{
+    return peekReadyHeap( &( (ShareDataType *)scheduler->policyData )->heap );
+}
+
+
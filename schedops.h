@@ -0,0 +1,504 @@
+#ifndef SCHED_OPS_H
+#define SCHED_OPS_H
+
+/*
+A scheduler selects which ready process runs on the cpu.
+Each policy is a set of hooks (SchedulerOpsType, see datatypes.h)
+   called by the simulator and the pcb manager:
+ - init, clear: create and free the policy's private data
+ - enqueue, dequeue: a process starts or stops being ready or running, 
+      called from setPCBState as the state changes
+ - pickNext: returns the process to run next
+ - onTick: called after every cycle the running process completes, 
+      returns if the process used up its time slice
+ - onBlock: called when the running process blocks for I/O
+ - shouldPreempt: called when an interrupt made processes ready, 
+      returns if the running process should give up the cpu at once
+ - report: displays the policy's own statistics at the end of the run
+Policies are found by the name used in the config file, 
+   a new policy needs its hooks and an entry in the scheduler table.
+FCFS and RR take processes in pid order from the manager's ready and
+   running lists; SJF and SRTF keep a ready heap ordered by remaining
+   time. SRTF also preempts the running process when a process 
+   returning from I/O has less time remaining.
+MLFQ keeps a looped run queue per level, linked through the processes. 
+   A process starts at level 0, drops a level each time it uses up its 
+   level's quantum, rises a level when it blocks for I/O, and every 
+   process returns to level 0 at each priority boost.
+CFS keeps a red-black tree ordered by virtual runtime, the msec each 
+   process has run, and runs the process with the least. A process 
+   keeps the cpu for at least the minimum granularity, then gives it 
+   up once another process has run less.
+Stride and lottery give each app a share of the cpu in proportion to 
+   the tickets on its app start line. Stride keeps a heap ordered by 
+   pass value, runs the lowest pass, and advances the running 
+   process's pass by its stride (STRIDE_ONE / tickets) each cycle. 
+   Lottery draws a ticket with a seeded generator each time slice.
+EDF keeps a ready heap ordered by deadline, from the optional deadline 
+   on each app start line, and preempts the running process when a 
+   process due sooner returns from I/O. Processes without a deadline 
+   run after those with one.
+*/
+
+#include "datatypes.h"
+#include "pcbops.h"
+
+// mlfq-p defaults, used when the config file does not set them
+#define DEFAULT_MLFQ_LEVELS 3
+#define DEFAULT_MLFQ_BOOST_CYCLES 100
+
+// mlfq-p private data, one run queue per level, level 0 runs first
+typedef struct MLFQDataStruct
+{
+    PCBType *levelHeads[ MAX_MLFQ_LEVELS ];
+    int levelCount;
+    int quanta[ MAX_MLFQ_LEVELS ];
+
+    // priority boost interval, and cycles run since the last boost
+    int boostCycles;
+    int cyclesSinceBoost;
+
+    // cycles run at each level, and moves between levels
+    long levelCycles[ MAX_MLFQ_LEVELS ];
+    int demotionCount, promotionCount, boostCount;
+} MLFQDataType;
+
+// cfs-p default, used when the config file does not set it
+#define DEFAULT_CFS_GRANULARITY_MSEC 30
+
+// cfs-p private data, the run tree and the process's current slice
+typedef struct CFSDataStruct
+{
+    RunTreeType tree;
+
+    // least virtual runtime in the tree, never decreases
+    long minVruntime;
+    int granularityMSec;
+
+    // process running the current slice, and msec it has run
+    PCBType *slicePcb;
+    int sliceMSec;
+    int sliceEndCount;
+} CFSDataType;
+
+// stride-p pass advanced per cycle by an app with a single ticket, 
+//    and the lottery-p seed used when the config file does not set one
+#define STRIDE_ONE 1000000
+#define DEFAULT_LOTTERY_SEED 1
+
+// an app's tickets, the cpu msec its tickets earned while it could run, 
+//    and the cpu msec it got, for the stride-p and lottery-p report
+typedef struct ShareRecordStruct
+{
+    int tickets;
+    double targetMSec;
+    long cpuMSec;
+
+    // entitlement clock when the app last became runnable
+    double joinTicketMSec;
+} ShareRecordType;
+
+// stride-p and lottery-p private data, a heap of the runnable 
+//    processes by pass, and a record per app by pid
+typedef struct ShareDataStruct
+{
+    ReadyHeapType heap;
+
+    // pass of the lowest process in the heap, never decreases
+    long globalPass;
+
+    // tickets held by runnable processes, and the entitlement clock, 
+    //    the cpu msec each runnable ticket has earned so far
+    long runnableTickets;
+    double ticketMSec;
+
+    // lottery generator state, and tickets drawn
+    unsigned long randomState;
+    int drawCount;
+
+    ShareRecordType *apps;
+} ShareDataType;
+
+
+/*
+Name: appendRunQueue
+Process: adds a process to the tail of the looped run queue at head
+*/
+void appendRunQueue( PCBType **head, PCBType *pcb );
+
+/*
+Name: cfsClear
+Process: frees the run tree data, the processes are not freed
+*/
+void cfsClear( SchedulerType *scheduler );
+
+/*
+Name: cfsDequeue
+Process: removes the process from the run tree
+*/
+void cfsDequeue( SchedulerType *scheduler, PCBType *pcb );
+
+/*
+Name: cfsEnqueue
+Process: adds the process to the run tree, a process returning from 
+            I/O or starting late is raised to the least virtual runtime 
+            so it cannot claim the cpu for the time it was away
+*/
+void cfsEnqueue( SchedulerType *scheduler, PCBType *pcb );
+
+/*
+Name: cfsInit
+Process: creates the empty run tree
+*/
+void cfsInit( SchedulerType *scheduler );
+
+/*
+Name: cfsOnTick
+Process: moves the process to its place in the run tree for its new 
+            virtual runtime (added by runCycle), 
+         returns if it has run the minimum granularity and another 
+            process now has less virtual runtime
+*/
+bool cfsOnTick( SchedulerType *scheduler, PCBType *pcb );
+
+/*
+Name: cfsPickNext
+Process: returns the ready or running process with the least virtual 
+            runtime, the lowest pid among equal runtimes
+*/
+PCBType *cfsPickNext( SchedulerType *scheduler );
+
+/*
+Name: cfsReport
+Process: displays the minimum granularity, the time slices it ended, 
+            and the final least virtual runtime
+*/
+void cfsReport( SchedulerType *scheduler );
+
+/*
+Name: cfsShouldPreempt
+Process: returns if a ready process trails the running process's 
+            virtual runtime by more than the minimum granularity
+*/
+bool cfsShouldPreempt( SchedulerType *scheduler, PCBType *current );
+
+/*
+Name: clearScheduler
+Process: frees the scheduler and its policy data, 
+         detaches it from its manager
+*/
+void clearScheduler( SchedulerType *scheduler );
+
+/*
+Name: createScheduler
+Process: creates the scheduler for the config's cpu schedule code, 
+            attached to the manager, 
+         must be created before any process becomes ready
+*/
+SchedulerType *createScheduler( PCBManagerType *manager, 
+                                                   ConfigDataType *configPtr );
+
+/*
+Name: displaySchedulerStats
+Process: for a preemptive policy, displays the policy, the average 
+            turnaround of the exited processes, and how many times 
+            a process was preempted, 
+         then displays the policy's own report
+*/
+void displaySchedulerStats( SchedulerType *scheduler );
+
+/*
+Name: edfInit
+Process: creates a deadline heap with room for every process
+*/
+void edfInit( SchedulerType *scheduler );
+
+/*
+Name: edfShouldPreempt
+Process: returns if a ready process with a deadline is due strictly 
+            before the running process, or the running process has none, 
+         ties and processes without deadlines never preempt
+*/
+bool edfShouldPreempt( SchedulerType *scheduler, PCBType *current );
+
+/*
+Name: fcfsPickNext
+Process: returns the ready or running process with the lowest pid
+*/
+PCBType *fcfsPickNext( SchedulerType *scheduler );
+
+/*
+Name: findSchedulerByCode
+Process: returns the policy with the config code, FCFS-N if none has it
+*/
+const SchedulerOpsType *findSchedulerByCode( ConfigDataCodes schedCode );
+
+/*
+Name: findSchedulerByName
+Process: returns the policy with the lower case config name, 
+         NULL if there is none
+*/
+const SchedulerOpsType *findSchedulerByName( const char *lowerCaseStr );
+
+/*
+Name: getNextReadyProcess
+Process: returns the ready or running process following afterPid
+            in pid order, wrapping around to the lowest pid, 
+         afterPid of NOT_IN_USE starts from the lowest pid, 
+         returns NULL if none found
+*/
+PCBType *getNextReadyProcess( PCBManagerType *manager, int afterPid );
+
+/*
+Name: ignoreProcess
+Process: hook for policies that need nothing done for the event
+*/
+void ignoreProcess( SchedulerType *scheduler, PCBType *pcb );
+
+/*
+Name: ignoreScheduler
+Process: init and clear hook for policies without private data
+*/
+void ignoreScheduler( SchedulerType *scheduler );
+
+/*
+Name: lotteryOnTick
+Process: charges the cycle to the process, 
+         returns if the process has run its quantum of cycles in a row
+*/
+bool lotteryOnTick( SchedulerType *scheduler, PCBType *pcb );
+
+/*
+Name: lotteryPickNext
+Process: draws a ticket among the ready and running processes, 
+            returns the process holding it, 
+         NULL if none are ready
+*/
+PCBType *lotteryPickNext( SchedulerType *scheduler );
+
+/*
+Name: lotteryRandom
+Process: returns the next value of the policy's own xorshift generator, 
+            so a seed draws the same tickets on every platform
+*/
+unsigned long lotteryRandom( ShareDataType *share );
+
+/*
+Name: mlfqBoost
+Process: returns every process to level 0 with a fresh quantum, 
+            the lower levels join level 0 in level order
+*/
+void mlfqBoost( SchedulerType *scheduler );
+
+/*
+Name: mlfqClear
+Process: frees the run queues, the processes are not freed
+*/
+void mlfqClear( SchedulerType *scheduler );
+
+/*
+Name: mlfqDequeue
+Process: removes the process from its level's run queue
+*/
+void mlfqDequeue( SchedulerType *scheduler, PCBType *pcb );
+
+/*
+Name: mlfqEnqueue
+Process: adds the process to the tail of its level's run queue, 
+         the running process shown blocked for an interrupt is not 
+            removed and added again, so it keeps its place in the level
+*/
+void mlfqEnqueue( SchedulerType *scheduler, PCBType *pcb );
+
+/*
+Name: mlfqInit
+Process: creates the empty run queues, 
+         a level without a configured quantum uses twice the quantum 
+            of the level above it, starting from Quantum Time
+*/
+void mlfqInit( SchedulerType *scheduler );
+
+/*
+Name: mlfqMoveLevel
+Process: moves a queued process to the tail of level's run queue 
+            with a fresh quantum
+*/
+void mlfqMoveLevel( MLFQDataType *mlfq, PCBType *pcb, int level );
+
+/*
+Name: mlfqOnBlock
+Process: raises a process blocking for I/O one level, 
+            so it returns from I/O ahead of the cpu bound processes
+*/
+void mlfqOnBlock( SchedulerType *scheduler, PCBType *pcb );
+
+/*
+Name: mlfqOnTick
+Process: counts the cycle against the process's level quantum, 
+         a process that used up its quantum drops a level, 
+            or rejoins the tail of the lowest level, 
+         boosts every process once the boost interval has run, 
+         returns if the process used up its quantum
+*/
+bool mlfqOnTick( SchedulerType *scheduler, PCBType *pcb );
+
+/*
+Name: mlfqPickNext
+Process: returns the process at the head of the highest non-empty level
+*/
+PCBType *mlfqPickNext( SchedulerType *scheduler );
+
+/*
+Name: mlfqReport
+Process: displays the quantum and the share of cycles run at each 
+            level, and the moves between levels
+*/
+void mlfqReport( SchedulerType *scheduler );
+
+/*
+Name: mlfqShouldPreempt
+Process: returns if a process is ready at a higher level than the 
+            running process
+*/
+bool mlfqShouldPreempt( SchedulerType *scheduler, PCBType *current );
+
+/*
+Name: neverPreempt
+Process: shouldPreempt hook for policies that let the running process 
+            keep the cpu through interrupts
+*/
+bool neverPreempt( SchedulerType *scheduler, PCBType *current );
+
+/*
+Name: neverTimeOut
+Process: onTick hook for policies that run a process until it blocks
+*/
+bool neverTimeOut( SchedulerType *scheduler, PCBType *pcb );
+
+/*
+Name: removeRunQueue
+Process: removes a process from the looped run queue at head
+*/
+void removeRunQueue( PCBType **head, PCBType *pcb );
+
+/*
+Name: rrOnTick
+Process: returns if the process has run its quantum of cycles in a row
+*/
+bool rrOnTick( SchedulerType *scheduler, PCBType *pcb );
+
+/*
+Name: rrPickNext
+Process: returns the ready or running process after the current one
+            in pid order, wrapping around, 
+         the lowest pid if none has run yet
+*/
+PCBType *rrPickNext( SchedulerType *scheduler );
+
+/*
+Name: shareChargeCycle
+Process: adds the cycle's msec to the process's cpu time, and the 
+            cycle's msec per runnable ticket to the entitlement clock
+*/
+void shareChargeCycle( SchedulerType *scheduler, PCBType *pcb );
+
+/*
+Name: shareClear
+Process: frees the pass heap and the per-app records
+*/
+void shareClear( SchedulerType *scheduler );
+
+/*
+Name: shareDequeue
+Process: removes the process from the pass heap, 
+         adds the cpu time its tickets earned while it could run 
+            to its target
+*/
+void shareDequeue( SchedulerType *scheduler, PCBType *pcb );
+
+/*
+Name: shareEnqueue
+Process: adds the process to the pass heap, a process returning from 
+            I/O or starting late is raised to the global pass 
+            so it cannot claim the cpu for the time it was away, 
+         starts timing its target from the entitlement clock
+*/
+void shareEnqueue( SchedulerType *scheduler, PCBType *pcb );
+
+/*
+Name: shareInit
+Process: creates a pass heap and per-app records with room for 
+            every process, seeds the lottery generator
+*/
+void shareInit( SchedulerType *scheduler );
+
+/*
+Name: shareReport
+Process: displays each app's tickets, the cpu time its tickets earned 
+            while it could run (its target), and the cpu time it got
+*/
+void shareReport( SchedulerType *scheduler );
+
+/*
+Name: sjfClear
+Process: frees the ready heap, also used by edf
+*/
+void sjfClear( SchedulerType *scheduler );
+
+/*
+Name: sjfDequeue
+Process: removes the process from the ready heap
+*/
+void sjfDequeue( SchedulerType *scheduler, PCBType *pcb );
+
+/*
+Name: sjfEnqueue
+Process: adds the process to the ready heap
+*/
+void sjfEnqueue( SchedulerType *scheduler, PCBType *pcb );
+
+/*
+Name: sjfInit
+Process: creates a ready heap with room for every process
+*/
+void sjfInit( SchedulerType *scheduler );
+
+/*
+Name: sjfOnTick
+Process: moves the process up the ready heap as its remaining time
+            drops (decrease-key), never ends its slice
+*/
+bool sjfOnTick( SchedulerType *scheduler, PCBType *pcb );
+
+/*
+Name: sjfPickNext
+Process: returns the ready or running process at the front of the 
+            ready heap, the least remaining time for sjf and srtf, 
+            the earliest deadline for edf
+*/
+PCBType *sjfPickNext( SchedulerType *scheduler );
+
+/*
+Name: srtfShouldPreempt
+Process: returns if a ready process has less time remaining than the 
+            running process
+*/
+bool srtfShouldPreempt( SchedulerType *scheduler, PCBType *current );
+
+/*
+Name: strideOnTick
+Process: charges the cycle to the process, advances its pass by its 
+            stride and moves it down the pass heap, 
+         returns if it has run its quantum and another process now 
+            has a lower pass
+*/
+bool strideOnTick( SchedulerType *scheduler, PCBType *pcb );
+
+/*
+Name: stridePickNext
+Process: returns the ready or running process with the lowest pass, 
+            the lowest pid among equal passes
+*/
+PCBType *stridePickNext( SchedulerType *scheduler );
+
+#endif // SCHED_OPS_H
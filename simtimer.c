@@ -21,6 +21,9 @@
 #ifndef SIMTIMER_C
 #define SIMTIMER_C
 
+// clock_nanosleep/clock_gettime are POSIX, not part of c99
+#define _POSIX_C_SOURCE 200809L
+
 // Header files ///////////////////////////////////////////////////////////////
 
 #include "simtimer.h"
@@ -29,56 +32,234 @@
 
 const char RADIX_POINT = '.';
 
-void runTimer( int milliSeconds )
+/*
+Name: addUSecToTime
+Process: moves a monotonic time forward by uSecTime, 
+         keeps nanoseconds below one second
+*/
+static void addUSecToTime( struct timespec *time, long uSecTime )
+{
+    time->tv_sec += uSecTime / 1000000;
+    time->tv_nsec += ( uSecTime % 1000000 ) * 1000;
+
+    if( time->tv_nsec >= 1000000000 )
+    {
+        time->tv_nsec -= 1000000000;
+        time->tv_sec++;
+    }
+}
+
+/*
+Name: uSecBetween
+Process: returns microseconds from startTime to endTime, 
+         negative if endTime is earlier
+*/
+static long uSecBetween( struct timespec *startTime, struct timespec *endTime )
+{
+    return ( endTime->tv_sec - startTime->tv_sec ) * 1000000 
+           + ( endTime->tv_nsec - startTime->tv_nsec ) / 1000;
+}
+
+/*
+Name: createTimerContext
+Process: allocates a timer context, 
+         defaults to real time with no dilation, timer not running
+*/
+TimerContextType *createTimerContext()
+{
+    TimerContextType *timer = (TimerContextType *)malloc( 
+                                                   sizeof( TimerContextType ) );
+
+    timer->running = false;
+    timer->startSec = 0;
+    timer->startUSec = 0;
+    timer->startTicks = 0;
+
+    timer->virtualMode = false;
+    timer->virtualUSec = 0;
+
+    timer->spinSliceUSec = DEFAULT_SPIN_SLICE_USEC;
+    timer->timeDilation = DEFAULT_TIME_DILATION;
+    timer->waitCorrectionUSec = 0;
+
+    timer->waitStats.waitCount = 0;
+    timer->waitStats.totalOvershootUSec = 0;
+    timer->waitStats.maxOvershootUSec = 0;
+    pthread_mutex_init( &timer->statsLock, NULL );
+
+    return timer;
+}
+
+/*
+Name: clearTimerContext
+Process: frees the timer context, 
+         no thread may be waiting on it
+*/
+TimerContextType *clearTimerContext( TimerContextType *timer )
+{
+    if( timer != NULL )
+    {
+        pthread_mutex_destroy( &timer->statsLock );
+        free( timer );
+    }
+
+    return NULL;
+}
+
+/*
+Name: monotonicUSec
+Process: returns the monotonic clock in microseconds
+*/
+static long monotonicUSec()
+{
+    struct timespec currentTime;
+
+    clock_gettime( CLOCK_MONOTONIC, &currentTime );
+
+    return (long) currentTime.tv_sec * 1000000 + currentTime.tv_nsec / 1000;
+}
+
+/*
+Name: waitRealUSec
+Process: waits waitUSec of real time, 
+         sleeps through all but the final spinUSec, then spins, 
+         returns how far past the requested end the wait returned
+*/
+static long waitRealUSec( TimerContextType *timer, long waitUSec, 
+                                                                 long spinUSec )
+{
+    struct timespec startTime, sleepEnd, waitEnd, currentTime;
+
+    clock_gettime( CLOCK_MONOTONIC, &startTime );
+
+    waitEnd = startTime;
+    addUSecToTime( &waitEnd, waitUSec );
+
+    // sleep through all but the final slice of the wait
+    if( waitUSec > spinUSec )
+    {
+        sleepEnd = startTime;
+        addUSecToTime( &sleepEnd, waitUSec - spinUSec );
+
+        // absolute end time, so a signal only needs the call repeated
+        while( clock_nanosleep( CLOCK_MONOTONIC, TIMER_ABSTIME, 
+                                                    &sleepEnd, NULL ) == EINTR )
+        {
+        }
+    }
+
+    // spin through the final slice for accuracy
+    clock_gettime( CLOCK_MONOTONIC, &currentTime );
+
+    while( uSecBetween( &currentTime, &waitEnd ) > 0 )
+    {
+        clock_gettime( CLOCK_MONOTONIC, &currentTime );
+    }
+
+    return uSecBetween( &waitEnd, &currentTime );
+}
+
+void runTimer( TimerContextType *timer, int milliSeconds )
    {
-    struct timeval startTime, endTime;
-    int startSec, startUSec, endSec, endUSec;
-    int uSecDiff, mSecDiff, secDiff, timeDiff;
+    long waitUSec, startTime, overshoot;
+
+    // virtual mode: advance the simulated clock instead of waiting
+    if( timer->virtualMode )
+       {
+        timer->virtualUSec += (long)milliSeconds * 1000;
 
-    gettimeofday( &startTime, NULL );
- 
-    startSec = startTime.tv_sec;
-    startUSec = startTime.tv_usec;
+        return;
+       }
 
-    timeDiff = 0;
+    // simulated milliseconds to real microseconds
+    waitUSec = (long)( milliSeconds * 1000 * timer->timeDilation );
+    startTime = monotonicUSec();
 
-    while( timeDiff < milliSeconds )
+    // end early by the calibrated overshoot, never below no wait
+    if( waitUSec > timer->waitCorrectionUSec )
        {
-        gettimeofday( &endTime, NULL );
+        waitRealUSec( timer, waitUSec - timer->waitCorrectionUSec, 
+                                                      timer->spinSliceUSec );
+       }
 
-        endSec = endTime.tv_sec;
-        endUSec = endTime.tv_usec;
-        uSecDiff = endUSec - startUSec;
+    // measured from the caller's view, so it includes the correction
+    overshoot = monotonicUSec() - startTime - waitUSec;
 
-        if( uSecDiff < 0 )
-           {
-            uSecDiff = uSecDiff + 1000000;
+    // record how far past the requested end the wait returned, 
+    //    negative if the correction ended it early
+    pthread_mutex_lock( &timer->statsLock );
 
-            endSec = endSec - 1;
-           }
+    timer->waitStats.waitCount++;
+    timer->waitStats.totalOvershootUSec += overshoot;
 
-        mSecDiff = uSecDiff / 1000;
-        secDiff = ( endSec - startSec ) * 1000;
-        timeDiff = secDiff + mSecDiff;
+    if( timer->waitStats.waitCount == 1 
+                             || overshoot > timer->waitStats.maxOvershootUSec )
+       {
+        timer->waitStats.maxOvershootUSec = overshoot;
        }
+
+    pthread_mutex_unlock( &timer->statsLock );
    }
 
-double accessTimer( int controlCode, char *timeStr )
+/*
+Name: runTimerUntil
+Process: waits until the timer reads uSecTicks simulated microseconds, 
+            sleeping the whole wait, without the final spin, 
+         returns immediately if already reached, 
+         in virtual mode, moves the simulated clock there instead, 
+         not included in the wait statistics
+*/
+void runTimerUntil( TimerContextType *timer, long uSecTicks )
+{
+    long remaining;
+
+    if( timer->virtualMode )
+    {
+        setVirtualTime( timer, uSecTicks );
+        return;
+    }
+
+    remaining = uSecTicks - getTimerTicks( timer );
+
+    if( remaining > 0 )
+    {
+        waitRealUSec( timer, (long)( remaining * timer->timeDilation ), 0 );
+    }
+}
+
+double accessTimer( TimerContextType *timer, int controlCode, char *timeStr )
    {
-    static bool running = false;
-    static int startSec = 0, endSec = 0, startUSec = 0, endUSec = 0;
-    static int lapSec = 0, lapUSec = 0;
+    int endSec = 0, endUSec = 0;
+    int lapSec = 0, lapUSec = 0;
     struct timeval startData, lapData, endData;
     double fpTime = 0.0;
 
+    // virtual mode: report the simulated clock instead of time of day
+    if( timer->virtualMode )
+       {
+        if( controlCode == ZERO_TIMER )
+           {
+            timer->virtualUSec = 0;
+           }
+
+        if( timeStr != NULL )
+           {
+            timeToString( timer->virtualUSec / 1000000, 
+                                   timer->virtualUSec % 1000000, timeStr );
+           }
+
+        return (double) timer->virtualUSec / 1000000;
+       }
+
     switch( controlCode )
        {
         case ZERO_TIMER:
            gettimeofday( &startData, NULL );
-           running = true;
+           timer->running = true;
 
-           startSec = startData.tv_sec;
-           startUSec = startData.tv_usec;
+           timer->startSec = startData.tv_sec;
+           timer->startUSec = startData.tv_usec;
+           timer->startTicks = monotonicUSec();
 
            fpTime = 0.000000000;
            lapSec = 0.000000000;
@@ -91,15 +272,15 @@ double accessTimer( int controlCode, char *timeStr )
            break;
            
         case LAP_TIMER:
-           if( running )
+           if( timer->running )
               {
                gettimeofday( &lapData, NULL );
 
                lapSec = lapData.tv_sec;
                lapUSec = lapData.tv_usec;
 
-               fpTime = processTime( startSec, lapSec, 
-                                                 startUSec, lapUSec, timeStr );
+               fpTime = processTime( timer, timer->startSec, lapSec, 
+                                          timer->startUSec, lapUSec, timeStr );
               }
 
            else
@@ -109,16 +290,16 @@ double accessTimer( int controlCode, char *timeStr )
            break;
 
         case STOP_TIMER:
-           if( running )
+           if( timer->running )
               {
                gettimeofday( &endData, NULL );
-               running = false;
+               timer->running = false;
 
                endSec = endData.tv_sec;
                endUSec = endData.tv_usec;
 
-               fpTime = processTime( startSec, endSec, 
-                                                 startUSec, endUSec, timeStr );
+               fpTime = processTime( timer, timer->startSec, endSec, 
+                                          timer->startUSec, endUSec, timeStr );
               }
 
            // assume timer not running
@@ -155,20 +336,42 @@ double accessTimer( int controlCode, char *timeStr )
     return fpTime;
    }
 
-double processTime( double startSec, double endSec, 
+/*
+Name: getTimerTicks
+Process: returns simulated microseconds since ZERO_TIMER, unformatted, 
+         cheap enough to take for every log line, 
+         0 if the timer is not running
+*/
+long getTimerTicks( TimerContextType *timer )
+{
+    if( timer->virtualMode )
+    {
+        return timer->virtualUSec;
+    }
+
+    if( !timer->running )
+    {
+        return 0;
+    }
+
+    // real elapsed time back to simulated time
+    return (long)( ( monotonicUSec() - timer->startTicks ) 
+                                                       / timer->timeDilation );
+}
+
+double processTime( TimerContextType *timer, double startSec, double endSec, 
                            double startUSec, double endUSec, char *timeStr )
    {
     double secDiff = endSec - startSec;
     double uSecDiff = endUSec - startUSec;
     double fpTime;
 
-    fpTime = (double) secDiff + (double) uSecDiff / 1000000;
+    // real elapsed time back to simulated time
+    fpTime = ( (double) secDiff + (double) uSecDiff / 1000000 ) 
+                                                       / timer->timeDilation;
 
-    if( uSecDiff < 0 )
-       {
-        uSecDiff = uSecDiff + 1000000;
-        secDiff = secDiff - 1;
-       }
+    secDiff = (long) fpTime;
+    uSecDiff = (long)( ( fpTime - secDiff ) * 1000000 );
 
     timeToString( secDiff, uSecDiff, timeStr );
 
@@ -255,16 +458,180 @@ void currentTimeToString( char *timeStr )
 }
 
 
-void *runTimerThread( void *delayVoidPtr )
+/*
+Name: setTimerMode
+Process: selects real time (wall clock) or virtual time (simulated clock), 
+         resets the wait statistics, 
+         must be set before the timer is zeroed
+*/
+void setTimerMode( TimerContextType *timer, int timerMode )
 {
-    int *delayPtr = (int *)delayVoidPtr;
-    int delay = *delayPtr;
+    timer->virtualMode = timerMode == VIRTUAL_TIME_MODE;
+    timer->virtualUSec = 0;
 
-    runTimer( delay );
+    pthread_mutex_lock( &timer->statsLock );
 
-    free( delayVoidPtr );
+    timer->waitStats.waitCount = 0;
+    timer->waitStats.totalOvershootUSec = 0;
+    timer->waitStats.maxOvershootUSec = 0;
 
-    return NULL;
+    pthread_mutex_unlock( &timer->statsLock );
+}
+
+/*
+Name: usingVirtualTime
+Process: returns if the timer runs on the simulated clock
+*/
+bool usingVirtualTime( TimerContextType *timer )
+{
+    return timer->virtualMode;
+}
+
+/*
+Name: getVirtualTime
+Process: returns the simulated clock in microseconds
+*/
+long getVirtualTime( TimerContextType *timer )
+{
+    return timer->virtualUSec;
+}
+
+/*
+Name: setVirtualTime
+Process: moves the simulated clock forward to uSecTime, 
+         the clock never moves backwards
+*/
+void setVirtualTime( TimerContextType *timer, long uSecTime )
+{
+    if( uSecTime > timer->virtualUSec )
+    {
+        timer->virtualUSec = uSecTime;
+    }
+}
+
+/*
+Name: setTimerSpinSlice
+Process: sets the final part of each real time wait that is spun, 
+         the rest of the wait is slept, 
+         a slice at least as long as a wait spins the whole wait
+*/
+void setTimerSpinSlice( TimerContextType *timer, int uSecSlice )
+{
+    timer->spinSliceUSec = uSecSlice;
+}
+
+/*
+Name: setTimeDilation
+Process: sets the real time spent per unit of simulated time, 
+         real time waits are scaled by it and timestamps rescaled 
+            so they still read in simulated time
+*/
+void setTimeDilation( TimerContextType *timer, double dilation )
+{
+    timer->timeDilation = dilation;
+}
+
+/*
+Name: calibrateTimer
+Process: in real time mode, makes CALIBRATION_WAITS short real time waits 
+            with the current spin slice, 
+         sets the wait correction to the median overshoot seen, 
+         returns the correction, 
+         the calibration waits are not included in the wait statistics
+*/
+long calibrateTimer( TimerContextType *timer )
+{
+    long overshoots[ CALIBRATION_WAITS ];
+    long startTime, tempOvershoot;
+    int index, sortIndex;
+
+    timer->waitCorrectionUSec = 0;
+
+    if( timer->virtualMode )
+    {
+        return 0;
+    }
+
+    for( index = 0; index < CALIBRATION_WAITS; index++ )
+    {
+        startTime = monotonicUSec();
+
+        waitRealUSec( timer, CALIBRATION_WAIT_USEC, timer->spinSliceUSec );
+
+        tempOvershoot = monotonicUSec() - startTime - CALIBRATION_WAIT_USEC;
+
+        // insertion sort, keeps overshoots ordered as they are measured
+        sortIndex = index;
+        while( sortIndex > 0 && overshoots[ sortIndex - 1 ] > tempOvershoot )
+        {
+            overshoots[ sortIndex ] = overshoots[ sortIndex - 1 ];
+            sortIndex--;
+        }
+        overshoots[ sortIndex ] = tempOvershoot;
+    }
+
+    // median is not thrown off by a wait the scheduler delayed
+    if( overshoots[ CALIBRATION_WAITS / 2 ] > 0 )
+    {
+        timer->waitCorrectionUSec = overshoots[ CALIBRATION_WAITS / 2 ];
+    }
+
+    return timer->waitCorrectionUSec;
+}
+
+/*
+Name: setWaitCorrection
+Process: sets how much earlier each real time wait ends, 
+         0 turns the correction off
+*/
+void setWaitCorrection( TimerContextType *timer, long uSecCorrection )
+{
+    timer->waitCorrectionUSec = uSecCorrection;
+}
+
+/*
+Name: getWaitCorrection
+Process: returns how much earlier each real time wait ends
+*/
+long getWaitCorrection( TimerContextType *timer )
+{
+    return timer->waitCorrectionUSec;
+}
+
+/*
+Name: getTimerStats
+Process: copies the overshoot statistics of all real time waits so far
+*/
+void getTimerStats( TimerContextType *timer, TimerStatsType *stats )
+{
+    pthread_mutex_lock( &timer->statsLock );
+
+    *stats = timer->waitStats;
+
+    pthread_mutex_unlock( &timer->statsLock );
+}
+
+/*
+Name: displayTimerStats
+Process: formats the overshoot statistics into statStr, 
+         empty string if no real time waits were made
+*/
+void displayTimerStats( TimerContextType *timer, char *statStr )
+{
+    TimerStatsType stats;
+
+    getTimerStats( timer, &stats );
+
+    statStr[ 0 ] = NULL_CHAR;
+
+    if( stats.waitCount > 0 )
+    {
+        sprintf( statStr, 
+                 "Timer waits: %d, overshoot avg %ld usec, max %ld usec, "
+                 "correction %ld usec\n", 
+                 stats.waitCount, stats.totalOvershootUSec / stats.waitCount, 
+                 stats.maxOvershootUSec, timer->waitCorrectionUSec );
+    }
 }
 
 
@@ -22,6 +22,9 @@
 // Header files ///////////////////////////////////////////////////////////////
 
 #include <sys/time.h>
+#include <time.h>
+#include <errno.h>
+#include <pthread.h>
 #include <string.h>
 #include <math.h>
 #include "StandardConstants.h"
@@ -32,16 +35,83 @@
 
 enum TIMER_CTRL_CODES { ZERO_TIMER, LAP_TIMER, STOP_TIMER };
 
+enum TIMER_MODE_CODES { REAL_TIME_MODE, VIRTUAL_TIME_MODE };
+
+// default final part of a real time wait that is spun instead of slept
+#define DEFAULT_SPIN_SLICE_USEC 200
+
+// default real time per simulated time, 1.0 runs in real time
+#define DEFAULT_TIME_DILATION 1.0
+
+// calibration waits made by calibrateTimer, and the length of each
+#define CALIBRATION_WAITS 15
+#define CALIBRATION_WAIT_USEC 1000
+
+// measured overshoot of real time waits past their requested end
+typedef struct TimerStatsStruct
+{
+    int waitCount;
+    long totalOvershootUSec;
+    long maxOvershootUSec;
+} TimerStatsType;
+
+// timer state owned by one simulation, so several may run in one process
+typedef struct TimerContextStruct
+{
+    // real time lap timer, started by ZERO_TIMER
+    // startTicks is the same start on the monotonic clock, in microseconds
+    bool running;
+    int startSec, startUSec;
+    long startTicks;
+
+    // virtual clock, in microseconds since ZERO_TIMER
+    // only advanced by runTimer when the timer is in virtual mode
+    bool virtualMode;
+    long virtualUSec;
+
+    // real time waits sleep until spinSliceUSec before their end, then spin
+    int spinSliceUSec;
+
+    // real time waits end this much early, the overshoot expected 
+    //    from the wait itself, measured by calibrateTimer
+    long waitCorrectionUSec;
+
+    // real time spent per unit of simulated time, 
+    // waits are multiplied by it and timestamps divided by it
+    double timeDilation;
+
+    // overshoot statistics shared by every waiting thread
+    TimerStatsType waitStats;
+    pthread_mutex_t statsLock;
+} TimerContextType;
+
 // Function Prototypes  ///////////////////////////////////////////////////////
 
-void runTimer( int milliSeconds );
-double accessTimer( int controlCode, char *timeStr );
-double processTime( double startSec, double endSec, 
+TimerContextType *createTimerContext();
+TimerContextType *clearTimerContext( TimerContextType *timer );
+
+void runTimer( TimerContextType *timer, int milliSeconds );
+void runTimerUntil( TimerContextType *timer, long uSecTicks );
+double accessTimer( TimerContextType *timer, int controlCode, char *timeStr );
+long getTimerTicks( TimerContextType *timer );
+double processTime( TimerContextType *timer, double startSec, double endSec, 
                            double startUSec, double endUSec, char *timeStr );
 void timeToString( int secTime, int uSecTime, char *timeStr );
-void *runTimerThread( void *delayVoidPtr );
 
 void currentTimeToString( char *timeStr );
 
+void setTimerMode( TimerContextType *timer, int timerMode );
+bool usingVirtualTime( TimerContextType *timer );
+long getVirtualTime( TimerContextType *timer );
+void setVirtualTime( TimerContextType *timer, long uSecTime );
+
+void setTimerSpinSlice( TimerContextType *timer, int uSecSlice );
+void setTimeDilation( TimerContextType *timer, double dilation );
+long calibrateTimer( TimerContextType *timer );
+void setWaitCorrection( TimerContextType *timer, long uSecCorrection );
+long getWaitCorrection( TimerContextType *timer );
+void getTimerStats( TimerContextType *timer, TimerStatsType *stats );
+void displayTimerStats( TimerContextType *timer, char *statStr );
+
 #endif // ifndef SIMTIMER_H
 
@@ -12,51 +12,84 @@ Memory not cleared
 #include "simulator.h"
 const bool START_OPERATION = true;
 const bool DO_NOT_START_OPERATION = false;
+const bool DO_NOT_NOTIFY_SCHEDULER = false;
 
 // simulator function
 void runSim( ConfigDataType *configPtr, OpCodeType *metaDataMstrPtr )
 {
+    TimerContextType *timer;
+    OutputFormatType *outputFormat;
     PCBManagerType *pcbManager;
     InterruptManager *interruptManager;
-    PCBType *interruptPCB;
+    SchedulerType *scheduler;
+    PCBType *interruptPCB, *preemptingPcb;
+    InterruptNode *interruptBatch = NULL;
     char outputString[ HUGE_STR_LEN ];
-    bool selectNextProgramFlag, selectNextProcessFlag;
+    bool selectNextProgramFlag, selectNextProcessFlag, sliceEnded;
     bool idling = false;
-    int operationTime;
+    bool coalescing = configPtr->coalesceWindowMSec > 0 
+                   || configPtr->coalesceCount > 0;
+    int operationTime, servicedCount;
+    int coalescedInterrupts = 0, coalescedCompletions = 0;
     PCBType *pcb; // temporary variable used to reduce code
     OpCodeType *opCode; // temporary variable used to reduce code
 
-    // initialize interrupt manager
-    interruptManager = createInterruptManager();
+    // initialize the timer owned by this simulation
+    timer = createTimerContext();
 
-    // identify if code is being logged to file/monitor
-    setFileOutput( configPtr->logToCode == LOGTO_FILE_CODE || 
-                   configPtr->logToCode == LOGTO_BOTH_CODE );
-    setConsoleOutput( configPtr->logToCode == LOGTO_MONITOR_CODE || 
-                      configPtr->logToCode == LOGTO_MONITOR_CODE );
+    // initialize the output owned by this simulation, 
+    //    identify if code is being logged to file/monitor
+    outputFormat = createOutputFormat( 
+                        configPtr->logToCode == LOGTO_MONITOR_CODE || 
+                        configPtr->logToCode == LOGTO_BOTH_CODE, 
+                        configPtr->logToCode == LOGTO_FILE_CODE || 
+                        configPtr->logToCode == LOGTO_BOTH_CODE );
 
     // create pcb manager from config data
-    pcbManager = createPCBManager( metaDataMstrPtr, configPtr );
+    pcbManager = createPCBManager( metaDataMstrPtr, configPtr, timer, 
+                                                               outputFormat );
+
+    // select the scheduling policy, before any process is ready
+    scheduler = createScheduler( pcbManager, configPtr );
 
     // display title
-    outputDirectly( "Simulator Run\n" );
-    outputDirectly( "-------------\n\n" );
+    outputDirectly( outputFormat, "Simulator Run\n" );
+    outputDirectly( outputFormat, "-------------\n\n" );
+
+    // select real or simulated clock, then prime timer
+    if( configPtr->virtualTimer )
+    {
+        setTimerMode( timer, VIRTUAL_TIME_MODE );
+    }
+    else
+    {
+        setTimerMode( timer, REAL_TIME_MODE );
+    }
+    setTimerSpinSlice( timer, configPtr->spinSliceUSec );
+    setTimeDilation( timer, configPtr->timeDilation );
+
+    // measure the usual wait overshoot, real time waits end early by it
+    calibrateTimer( timer );
 
-    // prime timer
-    accessTimer( ZERO_TIMER, NULL );
+    // initialize interrupt manager, its I/O worker follows the timer mode
+    interruptManager = createInterruptManager( timer, outputFormat, 
+                                                                  configPtr );
+
+    accessTimer( timer, ZERO_TIMER, NULL );
 
     // start simulator
-    output( "OS: Simulator start\n" );
+    output( outputFormat, timer, "OS: Simulator start\n" );
 
     // set all processes to ready
-    setAllProcessStates( pcbManager, "READY" );
+    setAllProcessStates( pcbManager, READY_STATE );
 
     // display memory
-    displayMemory( pcbManager->memory, "After memory initialization\n" );
+    displayMemory( pcbManager->memory, "After memory initialization\n", 
+                                                               outputFormat );
 
-    // select the first cycle
-    pcbManager->currentPcb = pcbManager->pcbHead;
-    setPCBToRunning( pcbManager->currentPcb, START_OPERATION );
+    // select the first process with the policy, as for every later one
+    pcbManager->currentPcb = scheduler->ops->pickNext( scheduler );
+    setPCBToRunning( timer, pcbManager->currentPcb, START_OPERATION );
 
     // iterate while a process is active or waiting for processes
     while( !allProcessesExited( pcbManager ) || 
@@ -66,9 +99,13 @@ void runSim( ConfigDataType *configPtr, OpCodeType *metaDataMstrPtr )
         // default, assume nothing needs to be modified
         selectNextProcessFlag = false;
         selectNextProgramFlag = false;
+        preemptingPcb = NULL;
 
-        // check for an io operation is ready to interrupt
-        interruptPCB = getInterruptProcess( interruptManager );
+        // check for an io operation is ready to interrupt, 
+        //    completions are drained a burst at a time, in service order, 
+        //    a new higher priority completion preempts the rest of the burst
+        collectInterrupts( interruptManager, &interruptBatch );
+        interruptPCB = getBatchProcess( interruptManager, &interruptBatch );
         if( interruptPCB != NULL )
         {
             // cpu is idling (no processes will be interrupted)
@@ -76,17 +113,33 @@ void runSim( ConfigDataType *configPtr, OpCodeType *metaDataMstrPtr )
             if( idling )
             {
                 // interrupt will be selected, no longer idle
-                output( "OS: CPU interrupt, end idle\n" );
+                output( outputFormat, timer, "OS: CPU interrupt, end idle\n" );
                 idling = false;
-                outputNewline();
+                outputNewline( outputFormat );
 
                 sprintf( outputString, "OS: Interrupted by process %i\n", 
                                        interruptPCB->pid );
-                output( outputString );
+                output( outputFormat, timer, outputString );
+
+                // the interrupting process is ready to run
+                setPCBState( timer, interruptPCB, READY_STATE );
+                servicedCount = 1;
+
+                // a coalesced interrupt services the rest of its batch, 
+                //    up to coalesceCount completions, 
+                //    before the interrupting process starts running
+                while( coalescing && interruptBatch != NULL 
+                    && ( configPtr->coalesceCount == 0 
+                        || servicedCount < configPtr->coalesceCount ) )
+                {
+                    collectInterrupts( interruptManager, &interruptBatch );
+                    simServiceInterrupt( pcbManager, 
+                           getBatchProcess( interruptManager, &interruptBatch ) );
+                    servicedCount++;
+                }
 
                 // start running the interrupting process
-                setPCBState( interruptPCB, "READY" );
-                setPCBToRunning( interruptPCB, DO_NOT_START_OPERATION );
+                setPCBToRunning( timer, interruptPCB, DO_NOT_START_OPERATION );
                 pcbManager->currentPcb = interruptPCB;
                 selectNextProgramFlag = true;
             }
@@ -102,40 +155,63 @@ void runSim( ConfigDataType *configPtr, OpCodeType *metaDataMstrPtr )
                       the interrupting process will be running until the 
                       interrupt ends.
                 */
-                // block the current process
-                output( "OS: Blocking current process for interrupt\n" );
-                setPCBState( pcbManager->currentPcb, "BLOCKED" );
-                outputNewline();
-
-                // start running the interrupting process
-                sprintf( outputString, "OS: Interrupted by process %i\n", 
-                                       interruptPCB->pid );
-                output( outputString );
-                setPCBState( interruptPCB, "RUNNING" );
-
-                // terminate the IO operation by selecting the next operation
-                selectNextProcessFlag = simSelectNextOperation( interruptPCB );
-
-                // check for process ended
-                if( selectNextProgramFlag )
-                {
-                    // interruptPCB was never selected, so don't interfere with 
-                    //   the selection process. 
-                    //   Instead, just end the interrupting state
-                    setPCBState( interruptPCB, "EXIT" );
-                    selectNextProcessFlag = false;
-                }
-                // otherwise, not done: the interrupting process is now ready
-                else
+                // block the current process, only for display, 
+                //    it keeps its place and slice in the policy's queues
+                output( outputFormat, timer, 
+                            "OS: Blocking current process for interrupt\n" );
+                changePCBState( timer, pcbManager->currentPcb, BLOCKED_STATE, 
+                                                   DO_NOT_NOTIFY_SCHEDULER );
+                outputNewline( outputFormat );
+
+                // run the interrupting process to the end of its operation
+                simServiceInterrupt( pcbManager, interruptPCB );
+                servicedCount = 1;
+
+                // a coalesced interrupt services its batch up to 
+                //    coalesceCount completions, the rest are left 
+                //    for the next interrupt
+                while( coalescing && interruptBatch != NULL 
+                    && ( configPtr->coalesceCount == 0 
+                        || servicedCount < configPtr->coalesceCount ) )
                 {
-                    setPCBState( interruptPCB, "READY" );
+                    collectInterrupts( interruptManager, &interruptBatch );
+                    simServiceInterrupt( pcbManager, 
+                           getBatchProcess( interruptManager, &interruptBatch ) );
+                    servicedCount++;
                 }
 
-                outputNewline();
+                outputNewline( outputFormat );
 
                 // continue running the current process
-                output( "OS: Done interrupting, continue with current\n" );
-                setPCBState( pcbManager->currentPcb, "RUNNING" );
+                output( outputFormat, timer, 
+                        "OS: Done interrupting, continue with current\n" );
+                changePCBState( timer, pcbManager->currentPcb, RUNNING_STATE, 
+                                                   DO_NOT_NOTIFY_SCHEDULER );
+
+                // the policy may hand the cpu to a process the 
+                //    interrupt made ready
+                if( scheduler->ops->shouldPreempt( scheduler, 
+                                                   pcbManager->currentPcb ) )
+                {
+                    // pick once, the logged process is the one switched to
+                    preemptingPcb = scheduler->ops->pickNext( scheduler );
+                    sprintf( outputString, 
+                             "OS: Process %i preempted by process %i\n", 
+                             pcbManager->currentPcb->pid, preemptingPcb->pid );
+                    output( outputFormat, timer, outputString );
+                    setPCBState( timer, pcbManager->currentPcb, READY_STATE );
+                    scheduler->preemptionCount++;
+
+                    // select the next process
+                    selectNextProcessFlag = true;
+                }
+            }
+
+            // count the completions this interrupt serviced
+            if( coalescing )
+            {
+                coalescedInterrupts++;
+                coalescedCompletions += servicedCount;
             }
         }
 
@@ -155,16 +231,17 @@ void runSim( ConfigDataType *configPtr, OpCodeType *metaDataMstrPtr )
             }
 
             // otherwise, check for preemptive input/output operation
-            else if( isPreemptive( configPtr ) && 
+            else if( scheduler->ops->preemptive && 
                      compareString( opCode->command, "dev" ) == 0 )
             {
                 // get the process time, reduce the remaining time here
                 operationTime = getCycleRate( opCode, configPtr ) * opCode->intArg2;
-                pcb->remainingTotalTime -= operationTime;
+                reducePCBTime( pcb, operationTime );
 
                 // send the operation to the interrupt manager
-                setPCBToBlocking( pcb );
-                sendProcessToInterrupt( interruptManager, pcb, operationTime );
+                setPCBToBlocking( timer, pcb );
+                sendProcessToInterrupt( interruptManager, pcb, operationTime, 
+                                                             opCode->strArg1 );
                 selectNextProcessFlag = true;
             }
 
@@ -176,11 +253,12 @@ void runSim( ConfigDataType *configPtr, OpCodeType *metaDataMstrPtr )
                 if( pcb->completedProgramCycles == 0 )
                 {
                     taskDataToString( outputString, pcb, PROCESS_NOT_ENDED );
-                    output( outputString );
+                    output( outputFormat, timer, outputString );
                 }
 
                 // reset quantum cycle count before looping
                 pcb->consecutiveCycles = 0;
+                sliceEnded = false;
 
                 // loop for cpu operation
                 // iterate until cpu process needs to end
@@ -188,28 +266,27 @@ void runSim( ConfigDataType *configPtr, OpCodeType *metaDataMstrPtr )
                        // cycles not completed
                        ( pcb->completedProgramCycles < opCode->intArg2 ) 
                        && 
-                       // nothing in interrupt manager
-                       isEmpty( interruptManager )
+                       // no interrupt due from the interrupt manager
+                       !interruptDue( interruptManager )
                        && 
-                       // quantum cycle limit not met
-                       ( !reachedQuantumCycleLimit( pcb, configPtr ) )
+                       // the scheduler has not ended its time slice
+                       !sliceEnded
                      )
                 {
-                    runCycle( pcb, configPtr );
+                    sliceEnded = runCycle( timer, pcb, configPtr );
                 }
 
                 // select the next program if all cycles completed
                 selectNextProgramFlag = pcb->completedProgramCycles >= 
                                         opCode->intArg2;
 
-                // if not completed, and met the quantum cycle limit
+                // if not completed, and the time slice ended
                 //    timing out is redundant if the operation already ended
-                if( !selectNextProgramFlag && 
-                    reachedQuantumCycleLimit( pcb, configPtr ) )
+                if( !selectNextProgramFlag && sliceEnded )
                 {
                     sprintf( outputString, "OS: Process %i quantum time out\n",
                                                                      pcb->pid );
-                    output( outputString );
+                    output( outputFormat, timer, outputString );
 
                     // skip to the next process
                     selectNextProcessFlag = true;
@@ -221,17 +298,18 @@ void runSim( ConfigDataType *configPtr, OpCodeType *metaDataMstrPtr )
         if( selectNextProgramFlag )
         {
             // check end of process
-            if( simSelectNextOperation( pcbManager->currentPcb ) )
+            if( simSelectNextOperation( timer, pcbManager->currentPcb ) )
             {
                 sprintf( outputString, "OS: Process %i ended\n", 
                                                pcbManager->currentPcb->pid );
-                output( outputString );
+                output( outputFormat, timer, outputString );
                 // clear memory from the current process
                 deallocateMemoryFromProcess( &pcbManager->memory, 
-                                             pcbManager->currentPcb->pid );
+                                             pcbManager->currentPcb->pid, 
+                                             outputFormat );
 
                 // clear the current process
-                setPCBState( pcbManager->currentPcb, "EXIT" );
+                setPCBState( timer, pcbManager->currentPcb, EXIT_STATE );
 
                 // select the next process
                 selectNextProcessFlag = true;
@@ -241,8 +319,9 @@ void runSim( ConfigDataType *configPtr, OpCodeType *metaDataMstrPtr )
         // next, move to next process if necessary or requested
         if( selectNextProcessFlag )
         {
-            // select the process for the simulator
-            simSelectNextProcess( pcbManager, configPtr->cpuSchedCode );
+            // select the process for the simulator, 
+            //    or the one already picked to preempt
+            simSelectNextProcess( pcbManager, preemptingPcb );
         }
 
         // check for no processes running in pcbManager
@@ -252,9 +331,16 @@ void runSim( ConfigDataType *configPtr, OpCodeType *metaDataMstrPtr )
             if( !idling )
             {
                 sprintf( outputString, "OS: CPU idle, all active processes blocked\n" );
-                output( outputString );
+                output( outputFormat, timer, outputString );
                 idling = true;
             }
+
+            // wait for an interrupt to end the idle, 
+            //    unless the drained burst still holds one
+            if( interruptBatch == NULL )
+            {
+                idleUntilInterrupt( interruptManager );
+            }
         }
     }
 
@@ -262,13 +348,66 @@ void runSim( ConfigDataType *configPtr, OpCodeType *metaDataMstrPtr )
     clearPCBList( pcbManager->pcbHead );
 
     // display memory after clearing memory
-    displayMemory( pcbManager->memory, "After clear all process success\n" );
+    displayMemory( pcbManager->memory, 
+                         "After clear all process success\n", outputFormat );
 
     // display simulation end
-    output( "OS: Simulation End\n" );
+    output( outputFormat, timer, "OS: Simulation End\n" );
+
+    // display the deadline miss ratio, if any process had a deadline
+    displayDeadlineStats( pcbManager );
+
+    // display timer accuracy, if diagnostics are on 
+    // and any real time waits were made
+    if( configPtr->diagnosticStats )
+    {
+        displayTimerStats( timer, outputString );
+        outputDirectly( outputFormat, outputString );
+    }
+
+    // display contention at each device used by an interrupt, if configured
+    displayDeviceStats( interruptManager );
+
+    // display operations held back by the in-flight cap, if set
+    displayAdmissionStats( interruptManager );
+
+    // display how often interrupt nodes were recycled, if diagnostics are on
+    displayNodePoolStats( interruptManager );
+
+    // display service latency by interrupt priority, if any were raised
+    displayPriorityStats( interruptManager );
+
+    // display the interrupts coalescing saved, if enabled
+    if( coalescing )
+    {
+        sprintf( outputString, 
+                 "Interrupt coalescing: %d completions in %d interrupts, "
+                 "saved %d context switches, %d log lines\n", 
+                 coalescedCompletions, coalescedInterrupts, 
+                 ( coalescedCompletions - coalescedInterrupts ) 
+                                               * INTERRUPT_CONTEXT_SWITCHES, 
+                 ( coalescedCompletions - coalescedInterrupts ) 
+                                               * INTERRUPT_LOG_LINES );
+        outputDirectly( outputFormat, outputString );
+    }
+
+    // display average turnaround and preemptions, if the policy preempts
+    displaySchedulerStats( scheduler );
 
     // output results to file
-    displayDataToFile( configPtr->logToFileName );
+    displayDataToFile( outputFormat, configPtr->logToFileName );
+
+    // stop the interrupt manager, all interrupts have completed
+    clearInterruptManager( interruptManager );
+
+    // clear the scheduler, no process is left to select
+    clearScheduler( scheduler );
+
+    // clear the timer, nothing is waiting on it
+    clearTimerContext( timer );
+
+    // clear the output, its log was written
+    clearOutputFormat( outputFormat );
 }
 
 /*
@@ -276,11 +415,11 @@ Name: simSelectNextOperation
 Process: moves to the next operation node, 
          returns if the process ended
 */
-bool simSelectNextOperation( PCBType *pcb )
+bool simSelectNextOperation( TimerContextType *timer, PCBType *pcb )
 {
     char outputString[ HUGE_STR_LEN ];
     taskDataToString( outputString, pcb, PROCESS_ENDED );
-    output( outputString );
+    output( pcb->manager->outputFormat, timer, outputString );
 
     // move to the next program, reset state
     pcb->programCounter = pcb->programCounter->nextNode;
@@ -290,93 +429,73 @@ bool simSelectNextOperation( PCBType *pcb )
     return pcb->programCounter == pcb->programEnd;
 }
 
-
 /*
-Name: simSelectNextProcess
-Process: selects the next process by schedCode, 
-         starts running the next process
+Name: simServiceInterrupt
+Process: runs an interrupting process to the end of its I/O operation, 
+         ends the process if that was its last operation, 
+            otherwise leaves it ready
 */
-void simSelectNextProcess( PCBManagerType *manager, ConfigDataCodes schedCode )
+void simServiceInterrupt( PCBManagerType *pcbManager, PCBType *interruptPCB )
 {
-    PCBType *nextProcess;
-
-    // reset consecutive process cycles
-    manager->currentPcb->consecutiveCycles = 0;
+    TimerContextType *timer = pcbManager->timer;
+    char outputString[ HUGE_STR_LEN ];
 
-    // identify/select the next process
-    nextProcess = getNextProcessByCode( manager, schedCode );
+    // start running the interrupting process
+    sprintf( outputString, "OS: Interrupted by process %i\n", 
+                           interruptPCB->pid );
+    output( pcbManager->outputFormat, timer, outputString );
+    setPCBState( timer, interruptPCB, RUNNING_STATE );
 
-    // only select the process if not already selected
-    if( nextProcess != manager->currentPcb )
+    // terminate the IO operation by selecting the next operation, 
+    //    then check for process ended
+    if( simSelectNextOperation( timer, interruptPCB ) )
     {
-        manager->currentPcb = nextProcess;
-        outputNewline();
-        setPCBToRunning( manager->currentPcb, START_OPERATION );
+        // interruptPCB was never selected, so don't interfere with 
+        //   the selection process. 
+        //   Instead, just end the interrupting state
+        sprintf( outputString, "OS: Process %i ended\n", 
+                                               interruptPCB->pid );
+        output( pcbManager->outputFormat, timer, outputString );
+        deallocateMemoryFromProcess( &pcbManager->memory, 
+                                     interruptPCB->pid, 
+                                     pcbManager->outputFormat );
+        setPCBState( timer, interruptPCB, EXIT_STATE );
+    }
+    // otherwise, not done: the interrupting process is now ready
+    else
+    {
+        setPCBState( timer, interruptPCB, READY_STATE );
     }
-
 }
 
 /*
-Name: getNextProcessByCode
-Process: selects the next process based on the current process and processCode
-         if processCode is PROCESS_NOT_ENDED, the process is only 
-            modified when the processCode allows processes to 
-            stop running before complete
+Name: simSelectNextProcess
+Process: selects pickedProcess, or the next process with the manager's 
+            scheduler if it is NULL, 
+         starts running the next process
 */
-PCBType *getNextProcessByCode( PCBManagerType *manager, 
-                               ConfigDataCodes schedCode )
+void simSelectNextProcess( PCBManagerType *manager, PCBType *pickedProcess )
 {
-    PCBType *nextProcess = NULL, *shortestProcess;
-    PCBType *iterator = NULL;
-
-    // first come first serve: choose next process from head (inclusive)
-    if( schedCode == CPU_SCHED_FCFS_N_CODE || 
-        schedCode == CPU_SCHED_FCFS_P_CODE )
-    {
-        nextProcess = getNextReadyProcess( manager->pcbHead, &iterator );
-    }
-
-    // srtf-p behaves the same as sjf-n
-    else if( schedCode == CPU_SCHED_SRTF_P_CODE || 
-             schedCode == CPU_SCHED_SJF_N_CODE )
-    {
-        // start iterating from head
-        nextProcess = getNextReadyProcess( manager->pcbHead, &iterator );
-
-        // start with first process as shortest
-        shortestProcess = nextProcess;
+    PCBType *nextProcess = pickedProcess;
 
-        // identify smallest processes by looping
-        while( nextProcess != NULL )
-        {
-            // set new shortest if applicable
-            if( nextProcess->remainingTotalTime < 
-                shortestProcess->remainingTotalTime )
-            {
-                shortestProcess = nextProcess;
-            }
-            nextProcess = getNextReadyProcess( manager->pcbHead, &iterator );
-        }
+    // reset consecutive process cycles
+    manager->currentPcb->consecutiveCycles = 0;
 
-        // set next process to the shortest one
-        nextProcess = shortestProcess;
-    }
-    // RR-P: choose next process from current (exlusive
-    else if( schedCode == CPU_SCHED_RR_P_CODE )
+    // identify/select the next process, unless already picked
+    if( nextProcess == NULL )
     {
-        // iterate to the next ready process
-        nextProcess = getNextReadyProcess( manager->currentPcb->next, &iterator );
+        nextProcess = manager->scheduler->ops->pickNext( manager->scheduler );
     }
-    // otherwise, default to FCFS
-    else
+
+    // only select the process if not already selected
+    if( nextProcess != manager->currentPcb )
     {
-        nextProcess = getNextProcessByCode( manager, CPU_SCHED_FCFS_N_CODE );
+        manager->currentPcb = nextProcess;
+        outputNewline( manager->outputFormat );
+        setPCBToRunning( manager->timer, manager->currentPcb, START_OPERATION );
     }
-    return nextProcess;
-}
-
-
 
+}
 
 /*
 Name: performMemoryOperation
@@ -432,38 +551,49 @@ void performMemoryOperation( PCBManagerType *pcbManager, OpCodeType *programCoun
         }
 
         // display memory
-        displayMemory( pcbManager->memory, memoryLabel );
+        displayMemory( pcbManager->memory, memoryLabel, 
+                                                    pcbManager->outputFormat );
     }
 }
 
 /*
 Name: runCycle
 Process: blocks program for one cycle, 
-         adjusts timing variables as needed
+         adjusts timing variables as needed, 
+         returns if the scheduler ended the process's time slice
 */
-void runCycle( PCBType *pcb, ConfigDataType *configPtr )
+bool runCycle( TimerContextType *timer, PCBType *pcb, 
+                                                    ConfigDataType *configPtr )
 {
+    SchedulerType *scheduler = pcb->manager->scheduler;
     int cycleTime = getCycleRate( pcb->programCounter, configPtr );
-    runTimer( cycleTime );
-    pcb->remainingTotalTime -= cycleTime;
+    runTimer( timer, cycleTime );
+    reducePCBTime( pcb, cycleTime );
     pcb->completedProgramCycles += 1;
     pcb->consecutiveCycles += 1;
+    pcb->vruntime += cycleTime;
+
+    return scheduler->ops->onTick( scheduler, pcb );
 }
 
 /*
 Name: setPCBToBlocking
 Process: sets pcb to blocked state, 
+         tells the scheduler it blocked for I/O, 
          outputs blocking message
 */
-void setPCBToBlocking( PCBType *pcb )
+void setPCBToBlocking( TimerContextType *timer, PCBType *pcb )
 {
     char outputString[ HUGE_STR_LEN ];
+    SchedulerType *scheduler;
     if( pcb != NULL )
     {
         sprintf( outputString, "OS: Process %i blocked for %sput operation\n", 
                  pcb->pid, pcb->programCounter->inOutArg );
-        output( outputString );
-        setPCBState( pcb, "BLOCKED" );
+        output( pcb->manager->outputFormat, timer, outputString );
+        scheduler = pcb->manager->scheduler;
+        scheduler->ops->onBlock( scheduler, pcb );
+        setPCBState( timer, pcb, BLOCKED_STATE );
     }
 }
 
@@ -473,40 +603,32 @@ Process: sets pcb to running state,
          outputs selected message
          if startOperation is set, displays that the process started
 */
-void setPCBToRunning( PCBType *pcb, bool startOperation )
+void setPCBToRunning( TimerContextType *timer, PCBType *pcb, 
+                                                         bool startOperation )
 {
     char outputString[ HUGE_STR_LEN ];
     if( pcb != NULL )
     {
         sprintf( outputString, "OS: Process %i selected with %i ms remaining\n", 
                  pcb->pid, pcb->remainingTotalTime );
-        output( outputString );
-        setPCBState( pcb, "RUNNING" );
+        output( pcb->manager->outputFormat, timer, outputString );
+        setPCBState( timer, pcb, RUNNING_STATE );
         if( startOperation )
         {
             taskDataToString( outputString, pcb, PROCESS_NOT_ENDED );
-            output( outputString );
+            output( pcb->manager->outputFormat, timer, outputString );
         }
     }
 }
 
 /*
 Name: allProcessesExited
-Process: returns if every process is in an EXIT state
+Process: returns if every process is in an EXIT state, 
+         the exit list's count is compared against every pid handed out
 */
 bool allProcessesExited( PCBManagerType *manager )
 {
-    PCBType *wkgPCB = NULL, *iter = NULL;
-    wkgPCB = iterateNextProcess( manager->pcbHead, &iter );
-    while( wkgPCB != NULL )
-    {
-        if( compareString( wkgPCB->state, "EXIT" ) != 0 )
-        {
-            return false;
-        }
-        wkgPCB = iterateNextProcess( manager->pcbHead, &iter );
-    }
-    return true;
+    return manager->stateCounts[ EXIT_STATE ] == manager->unusedPid;
 }
 
 // name: iterateNextProcess
@@ -539,35 +661,11 @@ PCBType *iterateNextProcess( PCBType *start, PCBType **iter )
     return (*iter)->prev;
 }
 
-/*
-Name: getNextReadyProcess
-Process: iterates to the next ready process, 
-         returns NULL if none found
-*/
-PCBType *getNextReadyProcess( PCBType *start, PCBType **iter )
-{
-    PCBType *nextProcess;
-
-    // get the next process
-    nextProcess = iterateNextProcess( start, iter );
-
-    // repeat if nextProcess is in a non-ready non-running state
-    if( nextProcess != NULL && 
-         ( !compareString( nextProcess->state, "READY" ) == 0 && 
-           !compareString( nextProcess->state, "RUNNING" ) == 0 )
-      )
-    {
-        nextProcess = getNextReadyProcess( start, iter );
-    }
-
-    return nextProcess;
-}
-
 /*
 Name: setAllProcessStates
 Process: sets state of all processes to specified state
 */
-void setAllProcessStates( PCBManagerType *manager, char *state )
+void setAllProcessStates( PCBManagerType *manager, ProcessState state )
 {
     PCBType *iterator = NULL;
     PCBType *nextProcess;
@@ -575,39 +673,11 @@ void setAllProcessStates( PCBManagerType *manager, char *state )
     nextProcess = iterateNextProcess( manager->pcbHead, &iterator );
     while( nextProcess != NULL )
     {
-        setPCBState( nextProcess, state );
+        setPCBState( manager->timer, nextProcess, state );
         nextProcess = iterateNextProcess( manager->pcbHead, &iterator );
     }
 }
 
-/*
-Name: reachedQuantumCycleLimit
-Process: returns if quantum cycle is being used and 
-         the process has ran for the cycle limit consecutively
-*/
-bool reachedQuantumCycleLimit( PCBType *pcb, ConfigDataType *configPtr )
-{
-    // skip if not round robin
-    if( configPtr->cpuSchedCode != CPU_SCHED_RR_P_CODE )
-    {
-        return false;
-    }
-
-    // return if consecutive cycles met quantum cycle limit
-    return pcb->consecutiveCycles >= configPtr->quantumCycles;
-}
-
-/*
-Name: isPreemptive
-Process: returns if the configPtr uses a preemptive code
-*/
-bool isPreemptive( ConfigDataType *configPtr )
-{
-    return configPtr->cpuSchedCode == CPU_SCHED_SRTF_P_CODE || 
-           configPtr->cpuSchedCode == CPU_SCHED_FCFS_P_CODE || 
-           configPtr->cpuSchedCode == CPU_SCHED_RR_P_CODE;
-}
-
 
 
 
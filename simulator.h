@@ -5,8 +5,14 @@
 #include "output.h"
 #include "pcbops.h"
 #include "interruptops.h"
+#include "schedops.h"
 
 
+// an interrupt of a running process blocks it and later resumes it, 
+//    logging both switches and the lines around the interrupt
+#define INTERRUPT_CONTEXT_SWITCHES 2
+#define INTERRUPT_LOG_LINES 6
+
 typedef enum 
 {
     PROCESS_ENDED, 
@@ -16,16 +22,6 @@ typedef enum
 // simulator function
 void runSim( ConfigDataType *configPtr, OpCodeType *metaDataMstrPtr );
 
-/*
-Name: getNextProcessByCode
-Process: selects the next process based on the current process and processCode
-         if processCode is PROCESS_NOT_ENDED, the process is only 
-            modified when the processCode allows processes to 
-            stop running before complete
-*/
-PCBType *getNextProcessByCode( PCBManagerType *manager, 
-                               ConfigDataCodes dataCode );
-
 /*
 Name: performMemoryOperation
 Process: performs a memory operation as described by the programCounter
@@ -44,18 +40,18 @@ Process: if the simulator has not began, sets the first process.
 */
 void selectNextCycle( PCBManagerType *pcbManager, ConfigDataType *configPtr );
 
-void runCycle( PCBType *pcb, ConfigDataType *configPtr );
-void setPCBToBlocking( PCBType *pcb );
-void setPCBToRunning( PCBType *pcb, bool startOperation );
+bool runCycle( TimerContextType *timer, PCBType *pcb, 
+                                                   ConfigDataType *configPtr );
+void setPCBToBlocking( TimerContextType *timer, PCBType *pcb );
+void setPCBToRunning( TimerContextType *timer, PCBType *pcb, 
+                                                        bool startOperation );
 bool allProcessesExited( PCBManagerType *manager );
 PCBType *getNextReadyProcessIterate( char *cmd, PCBType *start );
 PCBType *getProcessIterate( PCBType *start, PCBType **iter, bool *iterating );
-PCBType *getNextReadyProcess( PCBType *start, PCBType **iter );
 PCBType *iterateNextProcess( PCBType *start, PCBType **iter );
-void setAllProcessStates( PCBManagerType *manager, char *state );
-bool reachedQuantumCycleLimit( PCBType *pcb, ConfigDataType *configPtr );
-void simSelectNextProcess( PCBManagerType *manager, ConfigDataCodes schedCode );
-bool simSelectNextOperation( PCBType *pcb );
-bool isPreemptive( ConfigDataType *configPtr );
+void setAllProcessStates( PCBManagerType *manager, ProcessState state );
+void simSelectNextProcess( PCBManagerType *manager, PCBType *pickedProcess );
+void simServiceInterrupt( PCBManagerType *pcbManager, PCBType *interruptPCB );
+bool simSelectNextOperation( TimerContextType *timer, PCBType *pcb );
 
 #endif // SIMULATOR_H
@@ -0,0 +1,228 @@
+/*
+Timer benchmark, measures the accuracy and cost of the simulator timer
+usage: timerbench [max wait ms] [max threads]
+ - overshoot of runTimer for waits from 0 up to max wait ms, 
+      with 1 up to max threads waiting on the same timer at once
+ - per call cost of the lap timer and time formatting used for logging
+the timer is calibrated first, exactly as the simulator does, 
+   so the overshoot shown is what simulator waits see
+*/
+
+// clock_gettime is POSIX, not part of c99
+#define _POSIX_C_SOURCE 200809L
+
+// header files
+#include "simtimer.h"
+
+// benchmark constants
+#define DEFAULT_MAX_WAIT_MS 1000
+#define DEFAULT_MAX_THREADS 4
+#define WAIT_BUDGET_MS 250
+#define MIN_WAIT_REPS 5
+#define MAX_WAIT_REPS 50
+#define OVERHEAD_CALLS 200000
+
+// requested waits, in milliseconds
+static const int WAIT_SIZES[] = { 0, 1, 2, 5, 10, 20, 50, 100, 200, 500, 1000 };
+#define NUM_WAIT_SIZES ( (int)( sizeof( WAIT_SIZES ) / sizeof( int ) ) )
+
+// work for one waiting thread, overshoots are stored by the thread
+typedef struct BenchThreadStruct
+{
+    TimerContextType *timer;
+    int waitMs;
+    int reps;
+    long *overshoots;
+} BenchThreadType;
+
+/*
+Name: benchNowUSec
+Process: returns the monotonic clock in microseconds
+*/
+static long benchNowUSec()
+{
+    struct timespec currentTime;
+
+    clock_gettime( CLOCK_MONOTONIC, &currentTime );
+
+    return (long) currentTime.tv_sec * 1000000 + currentTime.tv_nsec / 1000;
+}
+
+/*
+Name: compareLong
+Process: qsort comparison for ascending longs
+*/
+static int compareLong( const void *left, const void *right )
+{
+    long leftValue = *(const long *)left;
+    long rightValue = *(const long *)right;
+
+    return ( leftValue > rightValue ) - ( leftValue < rightValue );
+}
+
+/*
+Name: benchWaitThread
+Process: makes reps waits of waitMs on the shared timer, 
+         stores how far past the requested end each returned
+*/
+static void *benchWaitThread( void *voidArgs )
+{
+    BenchThreadType *args = (BenchThreadType *)voidArgs;
+    long startTime;
+    int index;
+
+    for( index = 0; index < args->reps; index++ )
+    {
+        startTime = benchNowUSec();
+        runTimer( args->timer, args->waitMs );
+        args->overshoots[ index ] = benchNowUSec() - startTime
+                                                     - args->waitMs * 1000L;
+    }
+
+    return NULL;
+}
+
+/*
+Name: benchWaits
+Process: runs threadCount threads each waiting waitMs reps times, 
+         displays the overshoot distribution of every wait made
+*/
+static void benchWaits( TimerContextType *timer, int waitMs, int threadCount )
+{
+    BenchThreadType threadArgs[ threadCount ];
+    pthread_t threadIds[ threadCount ];
+    long *overshoots, total = 0;
+    int reps, index, count;
+
+    // keep each size near the same run time
+    reps = WAIT_BUDGET_MS / ( waitMs + 1 );
+    reps = reps < MIN_WAIT_REPS ? MIN_WAIT_REPS : reps;
+    reps = reps > MAX_WAIT_REPS ? MAX_WAIT_REPS : reps;
+    count = reps * threadCount;
+
+    overshoots = (long *)malloc( sizeof( long ) * count );
+
+    for( index = 0; index < threadCount; index++ )
+    {
+        threadArgs[ index ].timer = timer;
+        threadArgs[ index ].waitMs = waitMs;
+        threadArgs[ index ].reps = reps;
+        threadArgs[ index ].overshoots = &overshoots[ index * reps ];
+
+        pthread_create( &threadIds[ index ], NULL, 
+                                    benchWaitThread, &threadArgs[ index ] );
+    }
+
+    for( index = 0; index < threadCount; index++ )
+    {
+        pthread_join( threadIds[ index ], NULL );
+    }
+
+    qsort( overshoots, count, sizeof( long ), compareLong );
+
+    for( index = 0; index < count; index++ )
+    {
+        total += overshoots[ index ];
+    }
+
+    printf( "%7d %7d %5d %7ld %7ld %7ld %7ld %7ld %7ld\n", 
+            waitMs, threadCount, count, overshoots[ 0 ], 
+            overshoots[ count / 2 ], overshoots[ count * 9 / 10 ], 
+            overshoots[ count * 99 / 100 ], overshoots[ count - 1 ], 
+            total / count );
+
+    free( overshoots );
+}
+
+/*
+Name: benchOverhead
+Process: displays the average cost of each logging timer call
+*/
+static void benchOverhead( TimerContextType *timer )
+{
+    char timeStr[ MIN_STR_LEN ];
+    long startTime, ticks = 0;
+    int index;
+
+    printf( "\nPer call overhead, %d calls each\n", OVERHEAD_CALLS );
+
+    startTime = benchNowUSec();
+    for( index = 0; index < OVERHEAD_CALLS; index++ )
+    {
+        accessTimer( timer, LAP_TIMER, timeStr );
+    }
+    printf( "  accessTimer lap + format: %8.3f usec\n", 
+          (double)( benchNowUSec() - startTime ) / OVERHEAD_CALLS );
+
+    startTime = benchNowUSec();
+    for( index = 0; index < OVERHEAD_CALLS; index++ )
+    {
+        timeToString( index / 1000000, index % 1000000, timeStr );
+    }
+    printf( "  timeToString:             %8.3f usec\n", 
+          (double)( benchNowUSec() - startTime ) / OVERHEAD_CALLS );
+
+    startTime = benchNowUSec();
+    for( index = 0; index < OVERHEAD_CALLS; index++ )
+    {
+        ticks += getTimerTicks( timer );
+    }
+    printf( "  getTimerTicks:            %8.3f usec\n", 
+          (double)( benchNowUSec() - startTime ) / OVERHEAD_CALLS );
+
+    // keeps the ticks loop from being optimized away
+    if( ticks < 0 )
+    {
+        printf( "%ld\n", ticks );
+    }
+}
+
+int main( int argc, char **argv )
+{
+    TimerContextType *timer = createTimerContext();
+    int maxWaitMs = DEFAULT_MAX_WAIT_MS;
+    int maxThreads = DEFAULT_MAX_THREADS;
+    int sizeIndex, threadCount;
+    char statStr[ MAX_STR_LEN ];
+
+    if( argc > 1 )
+    {
+        maxWaitMs = atoi( argv[ 1 ] );
+    }
+    if( argc > 2 )
+    {
+        maxThreads = atoi( argv[ 2 ] );
+    }
+    maxThreads = maxThreads < 1 ? 1 : maxThreads;
+
+    printf( "\nTimer Benchmark\n" );
+    printf( "===============\n\n" );
+
+    // same setup as the simulator
+    setTimerMode( timer, REAL_TIME_MODE );
+    printf( "Spin slice: %d usec, calibrated correction: %ld usec\n\n", 
+                        DEFAULT_SPIN_SLICE_USEC, calibrateTimer( timer ) );
+    accessTimer( timer, ZERO_TIMER, NULL );
+
+    printf( "Overshoot past requested end, usec\n" );
+    printf( "%7s %7s %5s %7s %7s %7s %7s %7s %7s\n", "wait ms", "threads", 
+               "waits", "min", "median", "p90", "p99", "max", "avg" );
+
+    for( threadCount = 1; threadCount <= maxThreads; threadCount *= 2 )
+    {
+        for( sizeIndex = 0; sizeIndex < NUM_WAIT_SIZES
+                         && WAIT_SIZES[ sizeIndex ] <= maxWaitMs; sizeIndex++ )
+        {
+            benchWaits( timer, WAIT_SIZES[ sizeIndex ], threadCount );
+        }
+    }
+
+    displayTimerStats( timer, statStr );
+    printf( "\n%s", statStr );
+
+    benchOverhead( timer );
+    printf( "\n" );
+
+    clearTimerContext( timer );
+    return 0;
+}